@@ -55,6 +55,8 @@ void AudioDeviceBase::Release()
 
 void AudioDeviceBase::ProcessAudioMixing(void *stream, int32 length)
 {
+    PROFILE_SCOPE("AudioMixing");
+
     SAMPLE_FORMAT *streamF    = (SAMPLE_FORMAT *)stream;
     SAMPLE_FORMAT *streamEndF = ((SAMPLE_FORMAT *)stream) + length;
 
@@ -214,6 +216,9 @@ void RSDK::LoadStream(ChannelInfo *channel)
     if (channel->state != CHANNEL_LOADING_STREAM)
         return;
 
+    PROFILE_SCOPE_NAMED(profilerScope, "LoadStream");
+    PROFILE_DETAIL(profilerScope, streamFilePath);
+
     stb_vorbis_close(vorbisInfo);
 
     FileInfo info;
@@ -292,7 +297,15 @@ int32 RSDK::PlayStream(const char *filename, uint32 slot, uint32 startPos, uint3
     streamStartPos  = startPos;
     streamLoopPoint = loopPoint;
 
+#if RETRO_USE_JOB_SYSTEM
+    // async loads go to the job system instead of a thread of their own from the audio device
+    if (loadASync)
+        SubmitBackgroundJob([](void *channel) { LoadStream((ChannelInfo *)channel); }, channel, NULL);
+    else
+        LoadStream(channel);
+#else
     AudioDevice::HandleStreamLoad(channel, loadASync);
+#endif
 
     UnlockAudioDevice();
 
@@ -425,6 +438,9 @@ void RSDK::LoadSfxToSlot(char *filename, uint8 slot, uint8 plays, uint8 scope)
 
 void RSDK::LoadSfx(char *filename, uint8 plays, uint8 scope)
 {
+    PROFILE_SCOPE_NAMED(profilerScope, "LoadSfx");
+    PROFILE_DETAIL(profilerScope, filename);
+
     // Find an empty sound slot.
     uint16 id = -1;
     for (uint32 i = 0; i < SFX_COUNT; ++i) {
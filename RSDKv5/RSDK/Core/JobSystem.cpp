@@ -0,0 +1,281 @@
+// NOTE: this is included straight into RetroEngine.cpp
+
+#if RETRO_USE_JOB_SYSTEM
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#define JOBQUEUE_SIZE (0x400)
+
+struct Job {
+    JobFunction func;
+    void *data;
+    JobCounter *counter;
+};
+
+// a ring buffer of jobs, the thread that owns it pushes & pops at the back while anything that's run out of work steals from the front
+struct JobQueue {
+    std::mutex mutex;
+    Job jobs[JOBQUEUE_SIZE];
+    int32 head;
+    int32 count;
+};
+
+// queue 0 belongs to the main thread (& any other thread that isn't a worker), the rest are one per worker
+static std::thread jobThreads[JOBTHREAD_COUNT];
+static JobQueue jobQueues[JOBTHREAD_COUNT];
+static JobQueue backgroundJobQueue;
+static int32 jobThreadCount = 1;
+
+static std::mutex jobMutex;
+static std::condition_variable jobWake;
+static std::atomic<int32> jobsQueued(0);
+static std::atomic<int32> backgroundJobsQueued(0);
+static bool32 jobSystemQuit = false;
+
+static thread_local int32 jobThreadID = 0;
+
+static bool32 PushJob(JobQueue *queue, Job *job)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->count >= JOBQUEUE_SIZE)
+        return false;
+
+    queue->jobs[(queue->head + queue->count++) % JOBQUEUE_SIZE] = *job;
+    return true;
+}
+
+static bool32 PopJobBack(JobQueue *queue, Job *job)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->count)
+        return false;
+
+    *job = queue->jobs[(queue->head + --queue->count) % JOBQUEUE_SIZE];
+    return true;
+}
+
+static bool32 PopJobFront(JobQueue *queue, Job *job)
+{
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!queue->count)
+        return false;
+
+    *job        = queue->jobs[queue->head];
+    queue->head = (queue->head + 1) % JOBQUEUE_SIZE;
+    --queue->count;
+    return true;
+}
+
+// newest job on our own queue first (it's the most likely to still be in cache), then the oldest one on anyone else's
+static bool32 FindJob(Job *job, bool32 background)
+{
+    bool32 found = PopJobBack(&jobQueues[jobThreadID], job);
+    for (int32 i = 1; !found && i < jobThreadCount; ++i) found = PopJobFront(&jobQueues[(jobThreadID + i) % jobThreadCount], job);
+
+    if (found) {
+        --jobsQueued;
+        return true;
+    }
+
+    if (background && PopJobFront(&backgroundJobQueue, job)) {
+        --backgroundJobsQueued;
+        return true;
+    }
+
+    return false;
+}
+
+static void RunJob(Job *job)
+{
+    job->func(job->data);
+
+    if (job->counter && --job->counter->count == 0) {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobWake.notify_all();
+    }
+}
+
+static void QueueJob(JobFunction func, void *data, JobCounter *counter, bool32 background)
+{
+    Job job;
+    job.func    = func;
+    job.data    = data;
+    job.counter = counter;
+
+    if (counter)
+        ++counter->count;
+
+    // with no workers around (or the queue full) it just gets done now
+    if (jobThreadCount <= 1 || !PushJob(background ? &backgroundJobQueue : &jobQueues[jobThreadID], &job)) {
+        RunJob(&job);
+        return;
+    }
+
+    if (background)
+        ++backgroundJobsQueued;
+    else
+        ++jobsQueued;
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+    }
+    jobWake.notify_all();
+}
+
+static void JobThreadMain(int32 threadID)
+{
+    jobThreadID = threadID;
+
+    Job job;
+    while (true) {
+        if (FindJob(&job, true)) {
+            RunJob(&job);
+            continue;
+        }
+
+        // everything that's queued still gets run before quitting, anything waiting on it would never wake up otherwise
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobWake.wait(lock, [] { return jobSystemQuit || jobsQueued > 0 || backgroundJobsQueued > 0; });
+        if (jobSystemQuit && jobsQueued <= 0 && backgroundJobsQueued <= 0)
+            return;
+    }
+}
+
+void RSDK::InitJobSystem()
+{
+    ReleaseJobSystem();
+
+    // hardware_concurrency can be 0 if it doesn't know, there's always at least one worker so background jobs have somewhere to go
+    jobThreadCount = CLAMP((int32)std::thread::hardware_concurrency(), 2, JOBTHREAD_COUNT);
+    for (int32 t = 1; t < jobThreadCount; ++t) jobThreads[t] = std::thread(JobThreadMain, t);
+}
+
+void RSDK::ReleaseJobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+        jobSystemQuit = true;
+    }
+    jobWake.notify_all();
+
+    for (int32 t = 0; t < JOBTHREAD_COUNT; ++t) {
+        if (jobThreads[t].joinable())
+            jobThreads[t].join();
+    }
+
+    // the workers will have emptied the queues on their way out, but if there weren't any then whatever's left gets done here
+    Job job;
+    while (FindJob(&job, true)) RunJob(&job);
+
+    for (int32 t = 0; t < JOBTHREAD_COUNT; ++t) {
+        jobQueues[t].head  = 0;
+        jobQueues[t].count = 0;
+    }
+    backgroundJobQueue.head  = 0;
+    backgroundJobQueue.count = 0;
+
+    jobsQueued           = 0;
+    backgroundJobsQueued = 0;
+    jobSystemQuit        = false;
+    jobThreadCount       = 1;
+}
+
+int32 RSDK::GetJobThreadCount() { return jobThreadCount; }
+
+void RSDK::SubmitJob(JobFunction job, void *data, JobCounter *counter)
+{
+    if (job)
+        QueueJob(job, data, counter, false);
+}
+
+void RSDK::SubmitBackgroundJob(JobFunction job, void *data, JobCounter *counter)
+{
+    if (job)
+        QueueJob(job, data, counter, true);
+}
+
+void RSDK::WaitForJobCounter(JobCounter *counter)
+{
+    if (!counter)
+        return;
+
+    Job job;
+    while (counter->count > 0) {
+        if (FindJob(&job, false)) {
+            RunJob(&job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(jobMutex);
+        jobWake.wait(lock, [counter] { return counter->count <= 0 || jobsQueued > 0; });
+    }
+}
+
+struct ParallelForInfo {
+    JobRangeFunction func;
+    void *data;
+    int32 count;
+    int32 batchSize;
+    std::atomic<int32> next;
+};
+
+// every thread helping out keeps grabbing the next batch until there's none left, so slow batches don't hold anyone else up
+static void RunParallelForBatches(void *data)
+{
+    ParallelForInfo *info = (ParallelForInfo *)data;
+
+    for (int32 start = info->next.fetch_add(info->batchSize); start < info->count; start = info->next.fetch_add(info->batchSize))
+        info->func(info->data, start, MIN(start + info->batchSize, info->count));
+}
+
+void RSDK::ParallelFor(int32 count, int32 batchSize, JobRangeFunction job, void *data)
+{
+    if (count <= 0 || !job)
+        return;
+
+    // 4 batches per thread by default, so it evens out a bit if some take longer than others
+    if (batchSize <= 0)
+        batchSize = MAX((count + jobThreadCount * 4 - 1) / (jobThreadCount * 4), 1);
+
+    ParallelForInfo info;
+    info.func      = job;
+    info.data      = data;
+    info.count     = count;
+    info.batchSize = batchSize;
+    info.next      = 0;
+
+    JobCounter counter;
+    counter.count = 0;
+
+    int32 helperCount = MIN(jobThreadCount, (count + batchSize - 1) / batchSize) - 1;
+    for (int32 h = 0; h < helperCount; ++h) SubmitJob(RunParallelForBatches, &info, &counter);
+
+    RunParallelForBatches(&info);
+    WaitForJobCounter(&counter);
+}
+#else
+// everything just runs straight away on whichever thread asked for it
+void RSDK::InitJobSystem() {}
+void RSDK::ReleaseJobSystem() {}
+
+int32 RSDK::GetJobThreadCount() { return 1; }
+
+void RSDK::SubmitJob(JobFunction job, void *data, JobCounter *counter)
+{
+    if (job)
+        job(data);
+}
+void RSDK::SubmitBackgroundJob(JobFunction job, void *data, JobCounter *counter)
+{
+    if (job)
+        job(data);
+}
+void RSDK::WaitForJobCounter(JobCounter *counter) {}
+
+void RSDK::ParallelFor(int32 count, int32 batchSize, JobRangeFunction job, void *data)
+{
+    if (count > 0 && job)
+        job(data, 0, count);
+}
+#endif
@@ -0,0 +1,50 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#if RETRO_USE_JOB_SYSTEM
+#include <atomic>
+#endif
+
+namespace RSDK
+{
+
+#if RETRO_USE_JOB_SYSTEM
+#define JOBTHREAD_COUNT (0x10)
+#endif
+
+typedef void (*JobFunction)(void *data);
+// gets called with [start, end) ranges of the ParallelFor count
+typedef void (*JobRangeFunction)(void *data, int32 start, int32 end);
+
+// counts how many of the jobs submitted with it are still to finish, has to start out zeroed
+// (it's just a 32-bit int as far as game code's concerned, the engine's the only thing that should be touching it)
+struct JobCounter {
+#if RETRO_USE_JOB_SYSTEM
+    std::atomic<int32> count;
+#else
+    int32 count;
+#endif
+};
+
+// one worker per core (minus the main thread), anything that waits on a counter helps out with queued jobs instead of sleeping
+// NOTE: jobs run alongside the main thread, so they can't touch sceneInfo or call anything that relies on it (or draws)
+void InitJobSystem();
+// returns once every queued job (background ones included) has been run, so nothing waiting on a counter gets left hanging
+void ReleaseJobSystem();
+
+// the number of threads jobs can run on, including whichever thread is waiting on them
+int32 GetJobThreadCount();
+
+// queues "job" to be run on any thread, "counter" (if not NULL) gets incremented now & decremented once the job's done
+void SubmitJob(JobFunction job, void *data, JobCounter *counter);
+// same as SubmitJob, but for long-running work (file loading, path searches, etc) that'd stall a frame if it got picked up
+// by a thread waiting on something else, so only the workers ever run these
+void SubmitBackgroundJob(JobFunction job, void *data, JobCounter *counter);
+// runs "job" over [0, count) split into batches of "batchSize" (or however many it thinks is best if that's 0) & returns once it's all done
+void ParallelFor(int32 count, int32 batchSize, JobRangeFunction job, void *data);
+// returns once every job submitted with "counter" is done, running other queued jobs in the meantime
+void WaitForJobCounter(JobCounter *counter);
+
+} // namespace RSDK
+
+#endif
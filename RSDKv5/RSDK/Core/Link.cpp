@@ -76,6 +76,7 @@ void RSDK::SetupFunctionTables()
 
     CalculateTrigAngles();
     GenerateBlendLookupTable();
+    InitSpriteBlitters();
     InitSystemSurfaces();
 
     memset(RSDKFunctionTable, 0, sizeof(RSDKFunctionTable));
@@ -533,6 +534,20 @@ void RSDK::SetupFunctionTables()
     ADD_RSDK_FUNCTION(FunctionTable_SetGameFinished, SetGameFinished);
 #endif
 
+    // Engine Extras
+#if !RETRO_USE_ORIGINAL_CODE
+    ADD_RSDK_FUNCTION(FunctionTable_GetEntitiesInRect, GetEntitiesInRect);
+    ADD_RSDK_FUNCTION(FunctionTable_GetEntitiesNear, GetEntitiesNear);
+    ADD_RSDK_FUNCTION(FunctionTable_GetJobThreadCount, GetJobThreadCount);
+    ADD_RSDK_FUNCTION(FunctionTable_SubmitJob, SubmitJob);
+    ADD_RSDK_FUNCTION(FunctionTable_SubmitBackgroundJob, SubmitBackgroundJob);
+    ADD_RSDK_FUNCTION(FunctionTable_ParallelFor, ParallelFor);
+    ADD_RSDK_FUNCTION(FunctionTable_WaitForJobCounter, WaitForJobCounter);
+    ADD_RSDK_FUNCTION(FunctionTable_RegisterParallelUpdate, RegisterParallelUpdate);
+    ADD_RSDK_FUNCTION(FunctionTable_RegisterBatchedUpdate, RegisterBatchedUpdate);
+    ADD_RSDK_FUNCTION(FunctionTable_ProcessObjectMovementBatch, ProcessObjectMovementBatch);
+#endif
+
 #if RETRO_USE_MOD_LOADER
     InitModAPI();
 #endif
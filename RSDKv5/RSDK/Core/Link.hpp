@@ -322,6 +322,19 @@ enum FunctionTableIDs {
 #if RETRO_REV0U
     FunctionTable_NotifyCallback,
     FunctionTable_SetGameFinished,
+#endif
+#if !RETRO_USE_ORIGINAL_CODE
+    // Engine Extras, these come after everything official so existing game code doesn't need rebuilding
+    FunctionTable_GetEntitiesInRect,
+    FunctionTable_GetEntitiesNear,
+    FunctionTable_GetJobThreadCount,
+    FunctionTable_SubmitJob,
+    FunctionTable_SubmitBackgroundJob,
+    FunctionTable_ParallelFor,
+    FunctionTable_WaitForJobCounter,
+    FunctionTable_RegisterParallelUpdate,
+    FunctionTable_RegisterBatchedUpdate,
+    FunctionTable_ProcessObjectMovementBatch,
 #endif
     FunctionTable_Count,
 };
@@ -499,6 +499,8 @@ void RSDK::UnloadMods()
 
 void RSDK::LoadMods(bool newOnly, bool32 getVersion)
 {
+    PROFILE_SCOPE("LoadMods");
+
     if (!newOnly) {
         UnloadMods();
 
@@ -935,6 +937,20 @@ void RSDK::RunModCallbacks(int32 callbackID, void *data)
     if (callbackID < 0 || callbackID >= MODCB_MAX)
         return;
 
+#if RETRO_USE_PROFILER
+    int32 profilerCallback = -1;
+    switch (callbackID) {
+        default: break;
+        case MODCB_ONUPDATE: profilerCallback = PROFILER_CLASS_UPDATE; break;
+        case MODCB_ONLATEUPDATE: profilerCallback = PROFILER_CLASS_LATEUPDATE; break;
+        case MODCB_ONSTATICUPDATE: profilerCallback = PROFILER_CLASS_STATICUPDATE; break;
+        case MODCB_ONDRAW: profilerCallback = PROFILER_CLASS_DRAW; break;
+    }
+
+    bool32 profileCallbacks = profilerCallback >= 0 && !modCallbackList[callbackID].empty();
+    PROFILE_CLASS(profileCallbacks ? PROFILER_CLASS_MODCALLBACKS : -1, profilerCallback);
+#endif
+
     for (auto &c : modCallbackList[callbackID]) {
         if (c)
             c(data);
@@ -1570,6 +1586,9 @@ void SuperInternal(RSDK::ObjectClass *super, RSDK::ModSuper callback, void *data
     bool32 override = false;
     if (!super->inherited)
         return; // Mod.Super on an object that's literally an original object why did you do this
+#if RETRO_USE_PROFILER
+    ObjectClass *classInfo = super;
+#endif
     ++superLevels[inheritLevel];
     if (HASH_MATCH_MD5(super->hash, super->inherited->hash)) {
         // entity override
@@ -1586,6 +1605,11 @@ void SuperInternal(RSDK::ObjectClass *super, RSDK::ModSuper callback, void *data
         super = super->inherited;
     }
 
+#if RETRO_USE_PROFILER
+    // charged to the class that called Super, not the one it ends up running
+    PROFILE_CLASS(callback <= SUPER_DRAW ? (int32)(classInfo - objectClassList) : -1, PROFILER_CLASS_SUPER);
+#endif
+
     switch (callback) {
         case SUPER_UPDATE:
             if (super->update)
@@ -360,6 +360,11 @@ inline uint16 *GetPaletteBank(uint8 id)
 {
     if (id >= PALETTE_BANK_COUNT)
         return NULL;
+
+#if RETRO_USE_TILE_CACHE
+    // mods can write to the bank directly, so there's no telling when it changes
+    DisableTileColorCache(id);
+#endif
     return fullPalette[id];
 }
 inline uint8 *GetActivePaletteBuffer() { return gfxLineBuffer; }
@@ -8,6 +8,22 @@ RSDKContainer RSDK::dataPacks[DATAPACK_COUNT];
 uint8 RSDK::dataPackCount      = 0;
 uint16 RSDK::dataFileListCount = 0;
 
+uint16 RSDK::dataFileIndex[DATAFILE_INDEX_SIZE];
+uint32 RSDK::dataFileIndexGeneration = 1;
+
+// recently opened paths, so opening the same file again doesn't need to lowercase & MD5 it all over again
+// these are per-thread since files get opened from background jobs too (streamed music etc), & misses get cached as well
+#define DATAFILE_PATHCACHE_COUNT (0x20)
+#define DATAFILE_PATHCACHE_LEN   (0x80)
+
+struct DataFilePathCache {
+    char path[DATAFILE_PATHCACHE_LEN];
+    int32 fileID;
+    uint32 generation;
+};
+
+static thread_local DataFilePathCache dataFilePathCache[DATAFILE_PATHCACHE_COUNT];
+
 char RSDK::gameLogicName[0x200];
 
 bool32 RSDK::useDataPack = false;
@@ -156,6 +172,8 @@ bool32 RSDK::LoadDataPack(const char *filePath, size_t fileOffset, bool32 useBuf
 
         CloseFile(&info);
 
+        BuildDataFileIndex();
+
         return true;
     }
     else {
@@ -175,16 +193,36 @@ inline bool ends_with(std::string const &value, std::string const &ending)
 
 bool32 RSDK::OpenDataFile(FileInfo *info, const char *filename)
 {
-    char hashBuffer[0x400];
-    StringLowerCase(hashBuffer, filename);
-    RETRO_HASH_MD5(hash);
-    GEN_HASH_MD5_BUFFER(hashBuffer, hash);
+    PROFILE_SCOPE_NAMED(profilerScope, "OpenDataFile");
+    PROFILE_DETAIL(profilerScope, filename);
+
+    // the path's hashed as-is here, it's only ever matched against itself so there's no need to lowercase it first
+    uint32 pathHash = 0x811C9DC5;
+    int32 pathLen   = 0;
+    for (; filename[pathLen]; ++pathLen) pathHash = (pathHash ^ (uint8)filename[pathLen]) * 0x01000193;
+
+    DataFilePathCache *cached = &dataFilePathCache[pathHash % DATAFILE_PATHCACHE_COUNT];
+    int32 fileID              = -1;
+    if (cached->generation == dataFileIndexGeneration && !strcmp(cached->path, filename)) {
+        fileID = cached->fileID;
+    }
+    else {
+        char hashBuffer[0x400];
+        StringLowerCase(hashBuffer, filename);
+        RETRO_HASH_MD5(hash);
+        GEN_HASH_MD5_BUFFER(hashBuffer, hash);
 
-    for (int32 f = 0; f < dataFileListCount; ++f) {
-        RSDKFileInfo *file = &dataFileList[f];
+        fileID = FindDataFile(hash);
+
+        if (pathLen < DATAFILE_PATHCACHE_LEN) {
+            memcpy(cached->path, filename, pathLen + 1);
+            cached->fileID     = fileID;
+            cached->generation = dataFileIndexGeneration;
+        }
+    }
 
-        if (!HASH_MATCH_MD5(hash, file->hash))
-            continue;
+    if (fileID >= 0) {
+        RSDKFileInfo *file = &dataFileList[fileID];
 
         info->usingFileBuffer = file->useFileBuffer;
         if (!file->useFileBuffer) {
@@ -210,6 +248,7 @@ bool32 RSDK::OpenDataFile(FileInfo *info, const char *filename)
         info->encrypted  = file->encrypted;
         memset(info->encryptionKeyA, 0, 0x10 * sizeof(uint8));
         memset(info->encryptionKeyB, 0, 0x10 * sizeof(uint8));
+        PROFILE_BYTES(profilerScope, info->fileSize);
         if (info->encrypted) {
             GenerateELoadKeys(info, filename, info->fileSize);
             info->eKeyNo      = (info->fileSize / 4) & 0x7F;
@@ -232,11 +271,45 @@ bool32 RSDK::OpenDataFile(FileInfo *info, const char *filename)
     return false;
 }
 
+void RSDK::BuildDataFileIndex()
+{
+    memset(dataFileIndex, 0xFF, sizeof(dataFileIndex));
+    dataFileIndexGeneration++;
+
+    // files get added in list order & lookups return the first match along the probe chain, so duplicates resolve the same way a linear scan would
+    int32 fileCount = MIN((int32)dataFileListCount, DATAFILE_COUNT);
+    for (int32 f = 0; f < fileCount; ++f) {
+        uint32 slot = dataFileList[f].hash[0] & (DATAFILE_INDEX_SIZE - 1);
+        while (dataFileIndex[slot] != DATAFILE_INDEX_NONE) slot = (slot + 1) & (DATAFILE_INDEX_SIZE - 1);
+
+        dataFileIndex[slot] = f;
+    }
+}
+
+int32 RSDK::FindDataFile(uint32 *hash)
+{
+    // the index is only built once a pack's loaded
+    if (!dataFileListCount)
+        return -1;
+
+    // MD5 words are already about as well mixed as it gets, so the first one's used as-is
+    uint32 slot = hash[0] & (DATAFILE_INDEX_SIZE - 1);
+    for (; dataFileIndex[slot] != DATAFILE_INDEX_NONE; slot = (slot + 1) & (DATAFILE_INDEX_SIZE - 1)) {
+        if (HASH_MATCH_MD5(hash, dataFileList[dataFileIndex[slot]].hash))
+            return dataFileIndex[slot];
+    }
+
+    return -1;
+}
+
 bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
 {
     if (info->file)
         return false;
 
+    PROFILE_SCOPE_NAMED(profilerScope, "LoadFile");
+    PROFILE_DETAIL(profilerScope, filename);
+
     char fullFilePath[0x100];
     strcpy(fullFilePath, filename);
 
@@ -323,6 +396,7 @@ bool32 RSDK::LoadFile(FileInfo *info, const char *filename, uint8 fileMode)
         info->fileSize = (int32)fTell(info->file);
         fSeek(info->file, 0, SEEK_SET);
     }
+    PROFILE_BYTES(profilerScope, info->fileSize);
 #if !RETRO_USE_ORIGINAL_CODE
     PrintLog(PRINT_NORMAL, "Loaded file %s", fullFilePath);
 #endif
@@ -36,6 +36,9 @@ namespace RSDK
 
 #define DATAFILE_COUNT (0x1000)
 #define DATAPACK_COUNT (4)
+// open-addressed hash table over dataFileList, kept at half full or less so probe chains stay short
+#define DATAFILE_INDEX_SIZE (DATAFILE_COUNT * 2)
+#define DATAFILE_INDEX_NONE (0xFFFF)
 
 enum Scopes {
     SCOPE_NONE,
@@ -80,6 +83,9 @@ extern RSDKContainer dataPacks[DATAPACK_COUNT];
 
 extern uint8 dataPackCount;
 extern uint16 dataFileListCount;
+// slots hold dataFileList indices (or DATAFILE_INDEX_NONE), the generation's bumped whenever it's rebuilt so cached lookups know they're stale
+extern uint16 dataFileIndex[DATAFILE_INDEX_SIZE];
+extern uint32 dataFileIndexGeneration;
 
 extern char gameLogicName[0x200];
 
@@ -90,6 +96,9 @@ void DetectEngineVersion();
 #endif
 bool32 LoadDataPack(const char *filename, size_t fileOffset, bool32 useBuffer);
 bool32 OpenDataFile(FileInfo *info, const char *filename);
+void BuildDataFileIndex();
+// returns the dataFileList index of the first file matching "hash", or -1 if none of the loaded packs have it
+int32 FindDataFile(uint32 *hash);
 
 enum FileModes { FMODE_NONE, FMODE_RB, FMODE_WB, FMODE_RB_PLUS };
 
@@ -444,6 +453,9 @@ inline void ClearDataFiles()
     for (int32 f = 0; f < DATAFILE_COUNT; ++f) {
         HASH_CLEAR_MD5(dataFileList[f].hash);
     }
+
+    memset(dataFileIndex, 0xFF, sizeof(dataFileIndex));
+    dataFileIndexGeneration++;
 }
 
 } // namespace RSDK
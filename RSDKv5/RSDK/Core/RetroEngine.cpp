@@ -10,6 +10,8 @@ LogicLinkHandle RSDK::linkGameLogic = NULL;
 
 Link::Handle gameLogicHandle = NULL;
 
+#include "JobSystem.cpp"
+
 #if RETRO_PLATFORM == RETRO_ANDROID
 #include <jni.h>
 #include <unistd.h>
@@ -30,9 +32,14 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
         InitConsole();
     RenderDevice::isRunning = false;
 
+#if RETRO_USE_INPUT_RECORDING
+    InitInputRecording();
+#endif
+
     if (InitStorage()) {
         SKU::InitUserCore();
         LoadSettingsINI();
+        InitJobSystem();
 
 #if !RETRO_USE_ORIGINAL_CODE
         // temp fix till i properly figure out what exactly went wrong here
@@ -87,7 +94,19 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
             return 0;
         }
 
+#if RETRO_USE_PROFILER
+        // started past the early return so the trace thread's always stopped & joined on the way out
+        StartProfilerTrace();
+#endif
+
         InitEngine();
+#if RETRO_USE_INPUT_RECORDING
+        if (inputRecording.mode != INPUTRECORDING_NONE) {
+            // legacy scripts use rand() rather than RSDK's rng, so seed that too
+            srand(inputRecording.randSeed);
+            SetRandSeed(inputRecording.randSeed);
+        }
+#endif
 #if RETRO_USE_MOD_LOADER
         // we confirmed the game actually is valid & running, lets start some callbacks
         videoSettings.shaderID = shader;
@@ -116,6 +135,10 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
         if (RenderDevice::CheckFPSCap()) {
             RenderDevice::UpdateFPSCap();
 
+#if RETRO_USE_PROFILER
+            BeginProfilerFrame();
+#endif
+
             AudioDevice::FrameInit();
 
 #if RETRO_REV02
@@ -310,6 +333,7 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
                         // DrawDevString(buffer, currentScreen->center.x, currentScreen->center.y - 48, 1, 0xF0F0F0);
                     }
 
+                    PROFILE_SCOPE("CopyFrameBuffer");
                     RenderDevice::CopyFrameBuffer();
                 }
             }
@@ -317,6 +341,10 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
             if ((engine.focusState & 1) || engine.inFocus == 1)
                 RenderDevice::ProcessDimming();
 
+#if RETRO_USE_PROFILER
+            EndProfilerFrame();
+#endif
+
             RenderDevice::FlipScreen();
         }
     }
@@ -324,7 +352,21 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
     // Shutdown
 
     ReleaseInputDevices();
+#if RETRO_USE_INPUT_RECORDING
+    ReleaseInputRecording();
+#endif
+    // any stream that's still loading gets to finish before the audio device goes away
+    ReleaseJobSystem();
     AudioDevice::Release();
+#if RETRO_USE_RENDER_THREADS
+    ReleaseRenderThreads();
+#endif
+#if RETRO_USE_LAYER_CACHE
+    ReleaseLayerCaches();
+#endif
+#if RETRO_USE_TILE_CACHE
+    ReleaseTileColorCache();
+#endif
     RenderDevice::Release(false);
     SaveSettingsINI(false);
     SKU::ReleaseUserCore();
@@ -336,6 +378,10 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
     Link::Close(gameLogicHandle);
     gameLogicHandle = NULL;
 
+#if RETRO_USE_PROFILER
+    StopProfilerTrace();
+#endif
+
     if (engine.consoleEnabled)
         ReleaseConsole();
 
@@ -344,6 +390,8 @@ int32 RSDK::RunRetroEngine(int32 argc, char *argv[])
 
 void RSDK::ProcessEngine()
 {
+    PROFILE_SCOPE("ProcessEngine");
+
     switch (sceneInfo.state) {
         default: break;
 
@@ -366,6 +414,9 @@ void RSDK::ProcessEngine()
                 AddViewableVariable("Show Palettes", &engine.showPaletteOverlay, VIEWVAR_BOOL, false, true);
                 AddViewableVariable("Show Obj Range", &engine.showUpdateRanges, VIEWVAR_UINT8, 0, 2);
                 AddViewableVariable("Show Obj Info", &engine.showEntityInfo, VIEWVAR_UINT8, 0, 2);
+#if RETRO_USE_PROFILER
+                AddViewableVariable("Show Profiler", &engine.showProfiler, VIEWVAR_UINT8, 0, 2);
+#endif
 #endif
                 SKU::userCore->StageLoad();
                 for (int32 v = 0; v < DRAWGROUP_COUNT; ++v)
@@ -454,6 +505,9 @@ void RSDK::ProcessEngine()
             AddViewableVariable("Show Palettes", &engine.showPaletteOverlay, VIEWVAR_BOOL, false, true);
             AddViewableVariable("Show Obj Range", &engine.showUpdateRanges, VIEWVAR_UINT8, 0, 2);
             AddViewableVariable("Show Obj Info", &engine.showEntityInfo, VIEWVAR_UINT8, 0, 2);
+#if RETRO_USE_PROFILER
+            AddViewableVariable("Show Profiler", &engine.showProfiler, VIEWVAR_UINT8, 0, 2);
+#endif
 #endif
             SKU::userCore->StageLoad();
             for (int32 v = 0; v < DRAWGROUP_COUNT; ++v)
@@ -515,6 +569,10 @@ void RSDK::ProcessEngine()
 
             if (devMenu.state)
                 devMenu.state();
+
+#if RETRO_USE_PROFILER
+            DrawProfilerOverlay();
+#endif
             break;
 
         case ENGINESTATE_VIDEOPLAYBACK:
@@ -628,6 +686,63 @@ void RSDK::ParseArguments(int32 argc, char *argv[])
             engine.consoleEnabled = true;
             engine.devMenu        = true;
         }
+
+#if RETRO_USE_INPUT_RECORDING
+        find = strstr(argv[a], "recordinput=");
+        if (find) {
+            int32 b = 0;
+            int32 c = 12;
+            while (find[c] && find[c] != ';' && b < (int32)sizeof(inputRecording.filePath) - 1) inputRecording.filePath[b++] = find[c++];
+            inputRecording.filePath[b] = 0;
+            inputRecording.mode        = INPUTRECORDING_RECORD;
+        }
+
+        find = strstr(argv[a], "replayinput=");
+        if (find) {
+            int32 b = 0;
+            int32 c = 12;
+            while (find[c] && find[c] != ';' && b < (int32)sizeof(inputRecording.filePath) - 1) inputRecording.filePath[b++] = find[c++];
+            inputRecording.filePath[b] = 0;
+            inputRecording.mode        = INPUTRECORDING_REPLAY;
+        }
+#endif
+
+#if RETRO_USE_PROFILER
+        find = strstr(argv[a], "trace=");
+        if (find) {
+            int32 b = 0;
+            int32 c = 6;
+            while (find[c] && find[c] != ';' && b < (int32)sizeof(profiler.tracePath) - 1) profiler.tracePath[b++] = find[c++];
+            profiler.tracePath[b] = 0;
+        }
+#endif
+
+#if RETRO_RENDERDEVICE_NULL
+        find = strstr(argv[a], "headless_fps=");
+        if (find)
+            RenderDevice::targetFPS = atoi(find + 13);
+
+        find = strstr(argv[a], "headless_frames=");
+        if (find)
+            RenderDevice::frameLimit = atoi(find + 16);
+
+        find = strstr(argv[a], "headless_dump=");
+        if (find)
+            RenderDevice::frameDumpInterval = atoi(find + 14);
+
+        find = strstr(argv[a], "headless_dumpformat=");
+        if (find)
+            RenderDevice::frameDumpFormat = strstr(find, "png") ? FRAMEDUMP_PNG : FRAMEDUMP_RAW;
+
+        find = strstr(argv[a], "headless_dumppath=");
+        if (find) {
+            int32 b = 0;
+            int32 c = 18;
+            while (find[c] && find[c] != ';' && b < (int32)sizeof(RenderDevice::frameDumpPath) - 1)
+                RenderDevice::frameDumpPath[b++] = find[c++];
+            RenderDevice::frameDumpPath[b] = 0;
+        }
+#endif
     }
 }
 
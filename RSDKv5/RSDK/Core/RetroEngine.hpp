@@ -167,6 +167,7 @@ enum GameRegions {
 #define RETRO_RENDERDEVICE_GLFW (0)
 #define RETRO_RENDERDEVICE_VK   (0)
 #define RETRO_RENDERDEVICE_EGL  (0)
+#define RETRO_RENDERDEVICE_NULL (0)
 
 // ============================
 // AUDIO DEVICE BACKENDS
@@ -248,6 +249,91 @@ enum GameRegions {
 #define RETRO_MOD_LOADER_VER (2)
 #endif
 
+// Enables SIMD (SSE2/AVX2/NEON) paths in the software renderer, the best one available is picked at runtime
+#ifndef RETRO_USE_SIMD
+#define RETRO_USE_SIMD (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables caching tiles with their palette colours already looked up, so solid tile rows can be copied straight to the screen
+#ifndef RETRO_USE_TILE_CACHE
+#define RETRO_USE_TILE_CACHE (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables keeping a pre-drawn copy of layers that scroll as one solid block, so only tiles that scrolled in or changed get drawn each frame
+#ifndef RETRO_USE_LAYER_CACHE
+#define RETRO_USE_LAYER_CACHE (RETRO_USE_TILE_CACHE && 1)
+#endif
+
+// Enables drawing every cached layer the normal way too & logging any pixels that don't match what the cache drew (slow, for debugging only)
+#ifndef RETRO_VERIFY_LAYER_CACHE
+#define RETRO_VERIFY_LAYER_CACHE (RETRO_USE_LAYER_CACHE && 0)
+#endif
+
+// Enables storing tile layouts as 8x8 tile chunks rather than row by row, so walking a layout vertically stays in cache
+// NOTE: off by default, since any game code reading/writing TileLayer::layout directly expects it to be row by row
+#ifndef RETRO_USE_CHUNKED_LAYOUT
+#define RETRO_USE_CHUNKED_LAYOUT (0)
+#endif
+
+// Enables keeping a bitmap of which tiles are solid in each layer, so tile collision can skip past empty space without reading the layout,
+// along with a copy of the collision masks packed by direction so the ones that do get checked are next to each other
+// NOTE: game code can write to TileLayer::layout directly, so any layer handed out by GetTileLayer stops using its bitmap until the next scene
+// loads. a TileLayer pointer kept from an earlier scene & written through without calling GetTileLayer again isn't covered
+#ifndef RETRO_USE_SOLIDITY_BITMAPS
+#define RETRO_USE_SOLIDITY_BITMAPS (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables recording draw calls into a command stream per draw group, which gets replayed once the group is done
+#ifndef RETRO_USE_DRAW_COMMANDS
+#define RETRO_USE_DRAW_COMMANDS (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables the work-stealing thread pool behind SubmitJob/ParallelFor, when it's off jobs are just run straight away on the thread that submits them
+#ifndef RETRO_USE_JOB_SYSTEM
+#define RETRO_USE_JOB_SYSTEM (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables splitting each screen into horizontal bands that get drawn as jobs (see Video:renderThreads in settings.ini)
+#ifndef RETRO_USE_RENDER_THREADS
+#define RETRO_USE_RENDER_THREADS (RETRO_USE_DRAW_COMMANDS && RETRO_USE_JOB_SYSTEM && 1)
+#endif
+
+// Enables keeping a bitset of occupied entity slots so the Process*Objects loops only visit live entities
+#ifndef RETRO_USE_LIVE_ENTITY_LIST
+#define RETRO_USE_LIVE_ENTITY_LIST (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables mirroring the fields the culling switch reads into flat arrays once each entity's done for the frame, so the next frame can work out
+// every entity's range at once with SIMD & skip anything that's staying out of range in all of ProcessObjects' loops without touching it
+// NOTE: only ACTIVE_BOUNDS/XBOUNDS/YBOUNDS entities get skipped, & a far away one that gets moved (or has its active/updateRange changed) by
+// another object might get picked up up to 16 frames late, so this is off by default
+#ifndef RETRO_USE_ENTITY_HOT_FIELDS
+#define RETRO_USE_ENTITY_HOT_FIELDS (RETRO_USE_LIVE_ENTITY_LIST && 0)
+#endif
+
+// Enables keeping a bitset of slots per object class so GetAllEntities (foreach_all) only visits entities of the class it's looking for
+#ifndef RETRO_USE_CLASS_ENTITY_LIST
+#define RETRO_USE_CLASS_ENTITY_LIST (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables recording the input ProcessInput() produces each frame to a file & replaying it later (see "recordinput=" & "replayinput=")
+#ifndef RETRO_USE_INPUT_RECORDING
+#define RETRO_USE_INPUT_RECORDING (!RETRO_USE_ORIGINAL_CODE && 1)
+#endif
+
+// Enables timing the engine's main phases with PROFILE_SCOPE (& each object class with PROFILE_CLASS), shown in-game with the "Show Profiler" debug
+// flag & the dev menu's "Object Costs" page
+#ifndef RETRO_USE_PROFILER
+#define RETRO_USE_PROFILER (!RETRO_USE_ORIGINAL_CODE && 0)
+#endif
+
+// any state the rasterizer touches while drawing has to be per-thread once bands are drawn in parallel
+#if RETRO_USE_RENDER_THREADS
+#define RETRO_RENDER_TLS thread_local
+#else
+#define RETRO_RENDER_TLS
+#endif
+
 // ============================
 // PLATFORM INIT
 // ============================
@@ -355,8 +441,12 @@ enum GameRegions {
 #define RETRO_INPUTDEVICE_GLFW (1)
 #endif
 
+#elif defined(RSDK_USE_NULL)
+#undef RETRO_RENDERDEVICE_NULL
+#define RETRO_RENDERDEVICE_NULL (1)
+
 #else
-#error RSDK_USE_SDL2, RSDK_USE_OGL or RSDK_USE_VK must be defined.
+#error RSDK_USE_SDL2, RSDK_USE_OGL, RSDK_USE_VK or RSDK_USE_NULL must be defined.
 #endif //! RSDK_USE_SDL2
 
 #elif RETRO_PLATFORM == RETRO_SWITCH
@@ -544,10 +634,13 @@ extern "C" {
 #include "RSDK/Core/Math.hpp"
 #include "RSDK/Storage/Text.hpp"
 #include "RSDK/Core/Reader.hpp"
+#include "RSDK/Core/JobSystem.hpp"
 #include "RSDK/Graphics/Animation.hpp"
 #include "RSDK/Audio/Audio.hpp"
 #include "RSDK/Input/Input.hpp"
+#include "RSDK/Input/InputRecording.hpp"
 #include "RSDK/Scene/Object.hpp"
+#include "RSDK/Graphics/DrawCommands.hpp"
 #include "RSDK/Graphics/Palette.hpp"
 #include "RSDK/Graphics/Drawing.hpp"
 #include "RSDK/Graphics/Scene3D.hpp"
@@ -556,6 +649,7 @@ extern "C" {
 #include "RSDK/Graphics/Sprite.hpp"
 #include "RSDK/Graphics/Video.hpp"
 #include "RSDK/Dev/Debug.hpp"
+#include "RSDK/Dev/Profiler.hpp"
 #include "RSDK/User/Core/UserCore.hpp"
 #include "RSDK/User/Core/UserAchievements.hpp"
 #include "RSDK/User/Core/UserLeaderboards.hpp"
@@ -629,6 +723,9 @@ struct RetroEngine {
     bool32 showPaletteOverlay = false;
     uint8 showUpdateRanges    = 0;
     uint8 showEntityInfo      = 0;
+#if RETRO_USE_PROFILER
+    uint8 showProfiler = 0;
+#endif
     bool32 drawGroupVisible[DRAWGROUP_COUNT];
 
     // Image/Video support
@@ -25,6 +25,8 @@ ViewableVariable RSDK::viewableVarList[VIEWVAR_LIST_COUNT];
 
 DevMenu RSDK::devMenu = DevMenu();
 
+#include "Profiler.cpp"
+
 inline void PrintConsole(const char *message) { printf("%s", message); }
 
 void RSDK::PrintLog(int32 mode, const char *message, ...)
@@ -832,12 +834,8 @@ void RSDK::DevMenu_SceneSelectMenu()
 }
 void RSDK::DevMenu_OptionsMenu()
 {
-    const uint8 selectionCount = RETRO_REV02 ? 5 : 4;
-#if RETRO_REV02
-    uint32 selectionColors[] = { 0x808090, 0x808090, 0x808090, 0x808090, 0x808090 };
-#else
-    uint32 selectionColors[] = { 0x808090, 0x808090, 0x808090, 0x808090 };
-#endif
+    const uint8 selectionCount = (RETRO_REV02 ? 5 : 4) + (RETRO_USE_PROFILER ? 1 : 0);
+    uint32 selectionColors[]   = { 0x808090, 0x808090, 0x808090, 0x808090, 0x808090, 0x808090 };
     selectionColors[devMenu.selection] = 0xF0F0F0;
 
     int32 dy = currentScreen->center.y;
@@ -847,7 +845,11 @@ void RSDK::DevMenu_OptionsMenu()
     DrawDevString("OPTIONS", currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
 
     dy += 44;
+#if RETRO_USE_PROFILER
+    DrawRectangle(currentScreen->center.x - 128, dy - 8, 0x100, 0x54, 0x80, 0xFF, INK_NONE, true);
+#else
     DrawRectangle(currentScreen->center.x - 128, dy - 8, 0x100, 0x48, 0x80, 0xFF, INK_NONE, true);
+#endif
 
     DrawDevString("Video Settings", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[0]);
 
@@ -861,6 +863,11 @@ void RSDK::DevMenu_OptionsMenu()
     dy += 12;
     DrawDevString("Debug Flags", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[3]);
 
+#endif
+#if RETRO_USE_PROFILER
+    dy += 12;
+    DrawDevString("Object Costs", currentScreen->center.x, dy, ALIGN_CENTER, selectionColors[selectionCount - 2]);
+
 #endif
     DrawDevString("Back", currentScreen->center.x, dy + 12, ALIGN_CENTER, selectionColors[selectionCount - 1]);
 
@@ -942,10 +949,20 @@ void RSDK::DevMenu_OptionsMenu()
                 devMenu.scrollPos = 0;
 #endif
                 break;
+#endif
 
-            case 4:
+#if RETRO_USE_PROFILER
+            case RETRO_REV02 ? 4 : 3:
+                devMenu.state     = DevMenu_ProfilerMenu;
+                devMenu.selection = 0;
+                devMenu.scrollPos = 0;
+                break;
+#endif
+
+#if RETRO_REV02
+            case 4 + RETRO_USE_PROFILER:
 #else
-            case 3:
+            case 3 + RETRO_USE_PROFILER:
 #endif
                 devMenu.state     = DevMenu_MainMenu;
                 devMenu.selection = 0;
@@ -1815,6 +1832,202 @@ void RSDK::DevMenu_DebugOptionsMenu()
 }
 #endif
 
+#if RETRO_USE_PROFILER
+enum ProfilerMenuSortModes {
+    PROFILERSORT_TOTAL,
+    PROFILERSORT_UPDATE,
+    PROFILERSORT_LATEUPDATE,
+    PROFILERSORT_STATICUPDATE,
+    PROFILERSORT_DRAW,
+    PROFILERSORT_SUPER,
+    PROFILERSORT_PEAK,
+    PROFILERSORT_CALLS,
+    PROFILERSORT_COUNT,
+};
+
+#define PROFILER_EXPORT_PATH_SIZE (0x80)
+
+static uint8 profilerMenuSort = PROFILERSORT_TOTAL;
+// room for the export path along with the "Couldn't write ...!" around it
+static char profilerMenuStatus[PROFILER_EXPORT_PATH_SIZE + 0x10];
+
+static uint64 GetProfilerMenuSortValue(int32 classID)
+{
+    ProfilerClassStats *stats = &profilerClassStats[classID];
+
+    uint64 value = 0;
+    switch (profilerMenuSort) {
+        default:
+        case PROFILERSORT_TOTAL:
+            for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c) {
+                if (c != PROFILER_CLASS_SUPER)
+                    value += stats->time[c];
+            }
+            break;
+
+        case PROFILERSORT_UPDATE: value = stats->time[PROFILER_CLASS_UPDATE]; break;
+        case PROFILERSORT_LATEUPDATE: value = stats->time[PROFILER_CLASS_LATEUPDATE]; break;
+        case PROFILERSORT_STATICUPDATE: value = stats->time[PROFILER_CLASS_STATICUPDATE]; break;
+        case PROFILERSORT_DRAW: value = stats->time[PROFILER_CLASS_DRAW]; break;
+        case PROFILERSORT_SUPER: value = stats->time[PROFILER_CLASS_SUPER]; break;
+        case PROFILERSORT_PEAK: value = stats->peakTime; break;
+
+        case PROFILERSORT_CALLS:
+            for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c) value += stats->calls[c];
+            break;
+    }
+
+    return value;
+}
+
+void RSDK::DevMenu_ProfilerMenu()
+{
+    const char *sortNames[] = { "Total", "Update", "LateUpdate", "StaticUpdate", "Draw", "Super", "Peak Frame", "Calls" };
+
+    // sort every class that's been called at least once, there's only a couple hundred of 'em at most so insertion sort is fine
+    static uint16 classList[OBJECT_COUNT + 1];
+    static uint64 classValues[OBJECT_COUNT + 1];
+    int32 classCount = 0;
+    for (int32 i = 0; i <= OBJECT_COUNT; ++i) {
+        ProfilerClassStats *stats = &profilerClassStats[i];
+
+        uint32 calls = 0;
+        for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c) calls += stats->calls[c];
+        if (!calls)
+            continue;
+
+        uint64 value = GetProfilerMenuSortValue(i);
+
+        int32 pos = classCount++;
+        for (; pos > 0 && classValues[pos - 1] < value; --pos) {
+            classList[pos]   = classList[pos - 1];
+            classValues[pos] = classValues[pos - 1];
+        }
+        classList[pos]   = i;
+        classValues[pos] = value;
+    }
+
+    if (devMenu.selection >= classCount)
+        devMenu.selection = classCount ? classCount - 1 : 0;
+    if (devMenu.scrollPos > devMenu.selection)
+        devMenu.scrollPos = devMenu.selection;
+
+    uint32 selectionColors[]                               = { 0x808090, 0x808090, 0x808090, 0x808090, 0x808090, 0x808090, 0x808090, 0x808090 };
+    selectionColors[devMenu.selection - devMenu.scrollPos] = 0xF0F0F0;
+
+    int32 dy = currentScreen->center.y;
+    DrawRectangle(currentScreen->center.x - 128, dy - 84, 0x100, 0x30, 0x80, 0xFF, INK_NONE, true);
+
+    dy -= 68;
+    DrawDevString("OBJECT COSTS", currentScreen->center.x, dy, ALIGN_CENTER, 0xF0F0F0);
+
+    char buffer[0x40];
+    sprintf_s(buffer, sizeof(buffer), "< Sort: %s >", sortNames[profilerMenuSort]);
+    DrawDevString(buffer, currentScreen->center.x, dy + 12, ALIGN_CENTER, 0xF0F080);
+
+    dy += 40;
+    DrawRectangle(currentScreen->center.x - 128, dy - 4, 0x100, 0x58, 0x80, 0xFF, INK_NONE, true);
+
+    if (!classCount) {
+        DrawDevString("Nothing's been timed yet, turn on", currentScreen->center.x, dy + 24, ALIGN_CENTER, 0x808090);
+        DrawDevString("\"Show Profiler\" in the debug flags", currentScreen->center.x, dy + 32, ALIGN_CENTER, 0x808090);
+    }
+
+    // times are the average per frame since the scene loaded
+    uint32 frameCount = profilerClassFrames ? profilerClassFrames : 1;
+    for (int32 i = 0; i < 8 && devMenu.scrollPos + i < classCount; ++i) {
+        int32 classID = classList[devMenu.scrollPos + i];
+        DrawDevString(GetProfilerClassName(classID), currentScreen->center.x - 120, dy, ALIGN_LEFT, selectionColors[i]);
+
+        uint64 value = classValues[devMenu.scrollPos + i];
+        switch (profilerMenuSort) {
+            default: sprintf_s(buffer, sizeof(buffer), "%.3fms", (value / frameCount) / 1000000.0); break;
+            case PROFILERSORT_PEAK: sprintf_s(buffer, sizeof(buffer), "%.3fms", value / 1000000.0); break;
+            case PROFILERSORT_CALLS: sprintf_s(buffer, sizeof(buffer), "%.1f", value / (double)frameCount); break;
+        }
+        DrawDevString(buffer, currentScreen->center.x + 120, dy, ALIGN_RIGHT, 0xF0F080);
+
+        dy += 8;
+    }
+
+    if (profilerMenuStatus[0])
+        DrawDevString(profilerMenuStatus, currentScreen->center.x, currentScreen->center.y + 56, ALIGN_CENTER, 0x808090);
+    else
+        DrawDevString("Press A to export as CSV", currentScreen->center.x, currentScreen->center.y + 56, ALIGN_CENTER, 0x808090);
+
+#if !RETRO_USE_ORIGINAL_CODE
+    DevMenu_HandleTouchControls(CORNERBUTTON_LEFTRIGHT);
+#endif
+
+    if (controller[CONT_ANY].keyUp.press) {
+        if (--devMenu.selection < 0)
+            devMenu.selection = classCount ? classCount - 1 : 0;
+
+        devMenu.timer = 1;
+    }
+    else if (controller[CONT_ANY].keyUp.down) {
+        if (!devMenu.timer && --devMenu.selection < 0)
+            devMenu.selection = classCount ? classCount - 1 : 0;
+
+        devMenu.timer = (devMenu.timer + 1) & 7;
+    }
+
+    if (controller[CONT_ANY].keyDown.press) {
+        if (++devMenu.selection >= classCount)
+            devMenu.selection = 0;
+
+        devMenu.timer = 1;
+    }
+    else if (controller[CONT_ANY].keyDown.down) {
+        if (!devMenu.timer && ++devMenu.selection >= classCount)
+            devMenu.selection = 0;
+
+        devMenu.timer = (devMenu.timer + 1) & 7;
+    }
+
+    if (devMenu.selection >= devMenu.scrollPos) {
+        if (devMenu.selection > devMenu.scrollPos + 7)
+            devMenu.scrollPos = devMenu.selection - 7;
+    }
+    else {
+        devMenu.scrollPos = devMenu.selection;
+    }
+
+    if (controller[CONT_ANY].keyLeft.press) {
+        profilerMenuSort  = (profilerMenuSort + PROFILERSORT_COUNT - 1) % PROFILERSORT_COUNT;
+        devMenu.selection = 0;
+        devMenu.scrollPos = 0;
+    }
+    else if (controller[CONT_ANY].keyRight.press) {
+        profilerMenuSort  = (profilerMenuSort + 1) % PROFILERSORT_COUNT;
+        devMenu.selection = 0;
+        devMenu.scrollPos = 0;
+    }
+
+#if RETRO_REV02
+    bool32 swap = SKU::userCore->GetConfirmButtonFlip();
+#else
+    bool32 swap = SKU::GetConfirmButtonFlip();
+#endif
+
+    if (swap ? controller[CONT_ANY].keyB.press : controller[CONT_ANY].keyA.press) {
+        char filePath[PROFILER_EXPORT_PATH_SIZE];
+        sprintf_s(filePath, sizeof(filePath), "ObjectCosts_%s_%s.csv", currentSceneFolder, currentSceneID);
+
+        if (ExportProfilerClassStats(filePath))
+            sprintf_s(profilerMenuStatus, sizeof(profilerMenuStatus), "Saved to %s", filePath);
+        else
+            sprintf_s(profilerMenuStatus, sizeof(profilerMenuStatus), "Couldn't write %s!", filePath);
+    }
+    else if (swap ? controller[CONT_ANY].keyA.press : controller[CONT_ANY].keyB.press) {
+        profilerMenuStatus[0] = 0;
+        devMenu.state         = DevMenu_OptionsMenu;
+        devMenu.selection     = RETRO_REV02 ? 4 : 3;
+        devMenu.scrollPos     = 0;
+    }
+}
+#endif
+
 #if RETRO_USE_MOD_LOADER
 void RSDK::DevMenu_ModsMenu()
 {
@@ -134,6 +134,9 @@ void DevMenu_KeyMappingsMenu();
 #if RETRO_REV02
 void DevMenu_DebugOptionsMenu();
 #endif
+#if RETRO_USE_PROFILER
+void DevMenu_ProfilerMenu();
+#endif
 #if RETRO_USE_MOD_LOADER
 void DevMenu_ModsMenu();
 #endif
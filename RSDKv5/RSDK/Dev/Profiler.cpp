@@ -0,0 +1,415 @@
+// NOTE: this is included straight into Debug.cpp
+
+#if RETRO_USE_PROFILER
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+Profiler RSDK::profiler;
+
+// the frame that's being timed right now, zones can be timed on other threads (audio, render threads) so these have to be atomic
+static std::atomic<uint32> profilerZoneTime[PROFILER_ZONE_COUNT];
+static std::atomic<uint32> profilerZoneCalls[PROFILER_ZONE_COUNT];
+
+static thread_local int32 profilerCurrentZone = -1;
+
+#define PROFILER_NESTING(parent, depth)   (((parent) & 0xFF) | ((depth) << 8))
+#define PROFILER_NESTING_PARENT(nesting) ((int8)((nesting) & 0xFF))
+#define PROFILER_NESTING_DEPTH(nesting)  ((nesting) >> 8)
+
+ProfilerClassStats RSDK::profilerClassStats[OBJECT_COUNT + 1];
+uint32 RSDK::profilerClassFrames = 0;
+
+static uint64 profilerFrameStart  = 0;
+static bool32 profilerFrameActive = false;
+
+struct ProfilerTraceEvent {
+    const char *name;
+    uint64 start;
+    uint64 duration;
+    int32 threadID;
+    int32 bytes;
+    char detail[0x80];
+};
+
+// events get queued up by whatever thread finished them & written out by profilerTraceThread every so often
+static std::vector<ProfilerTraceEvent> profilerTraceEvents;
+static std::mutex profilerTraceMutex;
+static std::condition_variable profilerTraceWake;
+static std::thread profilerTraceThread;
+static bool32 profilerTraceStopping = false;
+
+static FileIO *profilerTraceFile = NULL;
+static uint64 profilerTraceStart = 0;
+
+static std::atomic<int32> profilerTraceThreadCount(0);
+static thread_local int32 profilerTraceThreadID = -1;
+
+static void AddProfilerTraceEvent(const char *name, uint64 startTicks, uint64 endTicks, const char *detail, int32 bytes)
+{
+    if (profilerTraceThreadID < 0)
+        profilerTraceThreadID = profilerTraceThreadCount.fetch_add(1);
+
+    ProfilerTraceEvent event;
+    event.name      = name;
+    event.start     = startTicks;
+    event.duration  = endTicks - startTicks;
+    event.threadID  = profilerTraceThreadID;
+    event.bytes     = bytes;
+    event.detail[0] = 0;
+
+    // file paths are the only thing that ends up in here, so just swap out anything that'd need escaping
+    if (detail) {
+        int32 c = 0;
+        for (; detail[c] && c < (int32)sizeof(event.detail) - 1; ++c) {
+            char chr        = detail[c];
+            event.detail[c] = chr == '\\' ? '/' : (chr == '"' || chr < ' ' ? '\'' : chr);
+        }
+        event.detail[c] = 0;
+    }
+
+    std::lock_guard<std::mutex> lock(profilerTraceMutex);
+    profilerTraceEvents.push_back(event);
+    if (profilerTraceEvents.size() >= 0x1000)
+        profilerTraceWake.notify_one();
+}
+
+static void WriteProfilerTraceEvents(std::vector<ProfilerTraceEvent> &events)
+{
+    // everything goes through one big buffer so the file only gets written to once per batch
+    static char buffer[0x10000];
+    int32 len = 0;
+
+    for (auto &event : events) {
+        len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+                         event.name, event.threadID, (event.start - profilerTraceStart) / 1000.0, event.duration / 1000.0);
+
+        if (event.detail[0] && event.bytes >= 0)
+            len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",\"args\":{\"file\":\"%s\",\"bytes\":%d}}", event.detail, event.bytes);
+        else if (event.detail[0])
+            len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",\"args\":{\"file\":\"%s\"}}", event.detail);
+        else if (event.bytes >= 0)
+            len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",\"args\":{\"bytes\":%d}}", event.bytes);
+        else
+            len += sprintf_s(&buffer[len], sizeof(buffer) - len, "}");
+
+        if (len > (int32)sizeof(buffer) - 0x200) {
+            fWrite(buffer, 1, len, profilerTraceFile);
+            len = 0;
+        }
+    }
+
+    if (len)
+        fWrite(buffer, 1, len, profilerTraceFile);
+}
+
+static void ProfilerTraceThreadMain()
+{
+    std::vector<ProfilerTraceEvent> events;
+
+    std::unique_lock<std::mutex> lock(profilerTraceMutex);
+    while (true) {
+        profilerTraceWake.wait_for(lock, std::chrono::milliseconds(250),
+                                   [] { return profilerTraceStopping || profilerTraceEvents.size() >= 0x1000; });
+
+        events.swap(profilerTraceEvents);
+        bool32 stopping = profilerTraceStopping;
+
+        lock.unlock();
+        WriteProfilerTraceEvents(events);
+        events.clear();
+        lock.lock();
+
+        if (stopping && profilerTraceEvents.empty())
+            break;
+    }
+}
+
+void RSDK::StartProfilerTrace()
+{
+    if (profiler.tracing || !profiler.tracePath[0])
+        return;
+
+    profilerTraceFile = fOpen(profiler.tracePath, "w");
+    if (!profilerTraceFile) {
+        PrintLog(PRINT_NORMAL, "ERROR: couldn't open trace file %s for writing!", profiler.tracePath);
+        return;
+    }
+
+    // whoever starts the trace is the main thread
+    profilerTraceThreadID = profilerTraceThreadCount.fetch_add(1);
+    profilerTraceStart    = GetProfilerTicks();
+
+    char buffer[0x100];
+    int32 len = sprintf_s(buffer, sizeof(buffer),
+                          "{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Main\"}}",
+                          profilerTraceThreadID);
+    fWrite(buffer, 1, len, profilerTraceFile);
+
+    profilerTraceStopping = false;
+    profilerTraceThread   = std::thread(ProfilerTraceThreadMain);
+    profiler.tracing      = true;
+
+    PrintLog(PRINT_NORMAL, "Writing trace to %s", profiler.tracePath);
+}
+
+void RSDK::StopProfilerTrace()
+{
+    if (!profiler.tracing)
+        return;
+
+    profiler.tracing = false;
+
+    {
+        std::lock_guard<std::mutex> lock(profilerTraceMutex);
+        profilerTraceStopping = true;
+    }
+    profilerTraceWake.notify_one();
+    profilerTraceThread.join();
+
+    const char *end = "\n]}\n";
+    fWrite(end, 1, strlen(end), profilerTraceFile);
+    fClose(profilerTraceFile);
+    profilerTraceFile = NULL;
+}
+
+int32 RSDK::RegisterProfilerZone(const char *name)
+{
+    int32 zoneID = profiler.zoneCount.fetch_add(1);
+    if (zoneID >= PROFILER_ZONE_COUNT) {
+        profiler.zoneCount = PROFILER_ZONE_COUNT;
+        PrintLog(PRINT_NORMAL, "WARNING: out of profiler zones, \"%s\" won't be timed", name);
+        return -1;
+    }
+
+    ProfilerZone *zone = &profiler.zones[zoneID];
+    zone->nesting      = PROFILER_NESTING(-2, 0); // not entered yet
+    zone->name         = name;
+
+    return zoneID;
+}
+
+int32 RSDK::BeginProfilerZone(int32 zoneID)
+{
+    ProfilerZone *zone = &profiler.zones[zoneID];
+    int32 nesting      = zone->nesting.load(std::memory_order_relaxed);
+    if (PROFILER_NESTING_PARENT(nesting) == -2) {
+        // the first thread in gets to pick the parent, anyone racing it just keeps whatever it picked
+        int32 depth = profilerCurrentZone >= 0 ? PROFILER_NESTING_DEPTH(profiler.zones[profilerCurrentZone].nesting.load()) + 1 : 0;
+        zone->nesting.compare_exchange_strong(nesting, PROFILER_NESTING(profilerCurrentZone, depth));
+    }
+
+    int32 parentID      = profilerCurrentZone;
+    profilerCurrentZone = zoneID;
+    return parentID;
+}
+
+void RSDK::EndProfilerZone(int32 zoneID, int32 parentID, uint64 startTicks, const char *traceDetail, int32 traceBytes)
+{
+    uint64 endTicks = GetProfilerTicks();
+
+    profilerZoneTime[zoneID] += (uint32)(endTicks - startTicks);
+    profilerZoneCalls[zoneID]++;
+
+    if (profiler.tracing)
+        AddProfilerTraceEvent(profiler.zones[zoneID].name, startTicks, endTicks, traceDetail, traceBytes);
+
+    profilerCurrentZone = parentID;
+}
+
+void RSDK::BeginProfilerFrame()
+{
+    if (profilerFrameActive)
+        EndProfilerFrame();
+
+    profiler.enabled    = engine.showProfiler != 0;
+    profilerFrameStart  = GetProfilerTicks();
+    profilerFrameActive = true;
+}
+
+void RSDK::EndProfilerFrame()
+{
+    if (!profilerFrameActive)
+        return;
+
+    profilerFrameActive = false;
+
+    uint64 frameEnd = GetProfilerTicks();
+    if (profiler.tracing)
+        AddProfilerTraceEvent("Frame", profilerFrameStart, frameEnd, NULL, -1);
+
+    ProfilerFrame *frame = &profiler.frames[profiler.frameID];
+    frame->frameTime     = (uint32)(frameEnd - profilerFrameStart);
+    for (int32 z = 0; z < PROFILER_ZONE_COUNT; ++z) {
+        frame->zoneTime[z]  = profilerZoneTime[z].exchange(0);
+        frame->zoneCalls[z] = profilerZoneCalls[z].exchange(0);
+    }
+
+    if (profiler.enabled) {
+        profiler.frameID = (profiler.frameID + 1) % PROFILER_FRAME_COUNT;
+        if (profiler.frameCount < PROFILER_FRAME_COUNT)
+            profiler.frameCount++;
+
+        for (int32 c = 0; c <= OBJECT_COUNT; ++c) {
+            ProfilerClassStats *stats = &profilerClassStats[c];
+            if (stats->frameTime > stats->peakTime)
+                stats->peakTime = stats->frameTime;
+            stats->frameTime = 0;
+        }
+        profilerClassFrames++;
+    }
+}
+
+void RSDK::ResetProfilerClassStats()
+{
+    memset(profilerClassStats, 0, sizeof(profilerClassStats));
+    profilerClassFrames = 0;
+}
+
+void RSDK::EndProfilerClassCall(int32 classID, int32 callback, uint64 startTicks)
+{
+    uint32 time = (uint32)(GetProfilerTicks() - startTicks);
+
+    ProfilerClassStats *stats = &profilerClassStats[classID];
+    stats->time[callback] += time;
+    stats->calls[callback]++;
+
+    if (callback != PROFILER_CLASS_SUPER)
+        stats->frameTime += time;
+}
+
+const char *RSDK::GetProfilerClassName(int32 classID)
+{
+    if (classID == PROFILER_CLASS_MODCALLBACKS)
+        return "Mod Callbacks";
+
+    return objectClassList[classID].name ? objectClassList[classID].name : "Unknown";
+}
+
+bool32 RSDK::ExportProfilerClassStats(const char *filePath)
+{
+    FileIO *file = fOpen(filePath, "w");
+    if (!file)
+        return false;
+
+    static const char *callbackNames[] = { "update", "lateUpdate", "staticUpdate", "draw", "super" };
+
+    char buffer[0x100];
+    int32 len = sprintf_s(buffer, sizeof(buffer), "class");
+    for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c)
+        len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",%sCalls,%sMS", callbackNames[c], callbackNames[c]);
+    len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",totalMS,avgFrameMS,peakFrameMS\n");
+    fWrite(buffer, 1, len, file);
+
+    // totals are over every frame since the scene loaded, super isn't part of totalMS since it's already in the other callbacks
+    uint32 frameCount = profilerClassFrames ? profilerClassFrames : 1;
+    for (int32 i = 0; i <= OBJECT_COUNT; ++i) {
+        ProfilerClassStats *stats = &profilerClassStats[i];
+
+        uint64 total = 0;
+        uint32 calls = 0;
+        for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c) {
+            if (c != PROFILER_CLASS_SUPER)
+                total += stats->time[c];
+            calls += stats->calls[c];
+        }
+
+        if (!calls)
+            continue;
+
+        len = sprintf_s(buffer, sizeof(buffer), "%s", GetProfilerClassName(i));
+        for (int32 c = 0; c < PROFILER_CLASS_CALLBACK_COUNT; ++c)
+            len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",%u,%.4f", stats->calls[c], stats->time[c] / 1000000.0);
+        len += sprintf_s(&buffer[len], sizeof(buffer) - len, ",%.4f,%.4f,%.4f\n", total / 1000000.0, (total / frameCount) / 1000000.0,
+                         stats->peakTime / 1000000.0);
+        fWrite(buffer, 1, len, file);
+    }
+
+    fClose(file);
+    return true;
+}
+
+static inline ProfilerFrame *GetProfilerFrame(int32 framesAgo)
+{
+    return &profiler.frames[(profiler.frameID - 1 - framesAgo + PROFILER_FRAME_COUNT) % PROFILER_FRAME_COUNT];
+}
+
+static void DrawProfilerZones(int32 parentID, int32 x, int32 *y, int32 frameCount)
+{
+    int32 zoneCount = profiler.zoneCount;
+    for (int32 z = 0; z < zoneCount; ++z) {
+        ProfilerZone *zone = &profiler.zones[z];
+        int32 nesting = zone->nesting;
+        if (!zone->name || PROFILER_NESTING_PARENT(nesting) != parentID)
+            continue;
+
+        uint64 time  = 0;
+        uint32 calls = 0;
+        for (int32 f = 0; f < frameCount; ++f) {
+            ProfilerFrame *frame = GetProfilerFrame(f);
+            time += frame->zoneTime[z];
+            calls += frame->zoneCalls[z];
+        }
+
+        if (!calls)
+            continue;
+
+        char buffer[0x20];
+        DrawRectangle(x - 2, *y, 0xF4, 8, 0x000000, 0xC0, INK_ALPHA, true);
+        DrawDevString(zone->name, x + (PROFILER_NESTING_DEPTH(nesting) << 3), *y, ALIGN_LEFT, 0xF0F0F0);
+
+        sprintf_s(buffer, sizeof(buffer), "%.2fms", (time / frameCount) / 1000000.0);
+        DrawDevString(buffer, x + 0xC0, *y, ALIGN_RIGHT, 0xF0F080);
+
+        sprintf_s(buffer, sizeof(buffer), "%d", (calls + (frameCount >> 1)) / frameCount);
+        DrawDevString(buffer, x + 0xF0, *y, ALIGN_RIGHT, 0x808090);
+        *y += 8;
+
+        DrawProfilerZones(z, x, y, frameCount);
+    }
+}
+
+void RSDK::DrawProfilerOverlay()
+{
+    if (!profiler.enabled || !profiler.frameCount)
+        return;
+
+    // the last 0x80 frames, the line halfway up is how long a frame's meant to take
+    int32 x           = 8;
+    int32 y           = 8;
+    int32 graphWidth  = 0x80;
+    int32 graphHeight = 0x30;
+    uint32 frameTime  = 1000000000 / (videoSettings.refreshRate > 0 ? videoSettings.refreshRate : 60);
+
+    DrawRectangle(x - 2, y - 2, graphWidth + 4, graphHeight + 4, 0x000000, 0xC0, INK_ALPHA, true);
+
+    int32 frameCount = profiler.frameCount < graphWidth ? profiler.frameCount : graphWidth;
+    for (int32 f = 0; f < frameCount; ++f) {
+        ProfilerFrame *frame = GetProfilerFrame(f);
+
+        int32 height = (int32)(((uint64)frame->frameTime * (graphHeight >> 1)) / frameTime);
+        if (height > graphHeight)
+            height = graphHeight;
+
+        DrawRectangle(x + graphWidth - 1 - f, y + graphHeight - height, 1, height, frame->frameTime > frameTime ? 0xF04040 : 0x40F040, 0xFF,
+                      INK_NONE, true);
+    }
+    DrawRectangle(x, y + (graphHeight >> 1), graphWidth, 1, 0xF0F080, 0x80, INK_ALPHA, true);
+
+    // everything past the graph is averaged over the last second or so
+    int32 avgCount = profiler.frameCount < 60 ? profiler.frameCount : 60;
+
+    uint64 totalTime = 0;
+    for (int32 f = 0; f < avgCount; ++f) totalTime += GetProfilerFrame(f)->frameTime;
+
+    char buffer[0x20];
+    sprintf_s(buffer, sizeof(buffer), "%.2fms", (totalTime / avgCount) / 1000000.0);
+    DrawDevString(buffer, x, y + graphHeight + 4, ALIGN_LEFT, 0xF0F0F0);
+
+    if (engine.showProfiler >= 2) {
+        int32 zoneY = y + graphHeight + 16;
+        DrawProfilerZones(-1, x, &zoneY, avgCount);
+    }
+}
+
+#endif
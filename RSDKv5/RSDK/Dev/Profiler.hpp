@@ -0,0 +1,170 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#if RETRO_USE_PROFILER
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace RSDK
+{
+
+#if RETRO_USE_PROFILER
+
+#define PROFILER_FRAME_COUNT (0x100)
+#define PROFILER_ZONE_COUNT  (0x40)
+
+// a named block of code that gets timed, zones are nested under whichever zone was running the first time they're entered
+struct ProfilerZone {
+    const char *name;
+    // parent zone in the low byte (-2 until it's first entered) & depth in the next, packed so whichever thread enters it first can set both at once
+    std::atomic<int32> nesting;
+};
+
+struct ProfilerFrame {
+    uint32 frameTime; // nanoseconds
+    uint32 zoneTime[PROFILER_ZONE_COUNT];
+    uint16 zoneCalls[PROFILER_ZONE_COUNT];
+};
+
+struct Profiler {
+    ProfilerZone zones[PROFILER_ZONE_COUNT];
+    std::atomic<int32> zoneCount;
+    // ring buffer of the last PROFILER_FRAME_COUNT frames, frameID is the next one to be written
+    ProfilerFrame frames[PROFILER_FRAME_COUNT];
+    int32 frameID;
+    int32 frameCount;
+    bool32 enabled;
+    // set by the "trace=" arg, every zone (& every frame) gets written to this file as a chrome trace event while tracing's on
+    char tracePath[0x100];
+    bool32 tracing;
+};
+
+extern Profiler profiler;
+
+inline uint64 GetProfilerTicks()
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int32 RegisterProfilerZone(const char *name);
+int32 BeginProfilerZone(int32 zoneID);
+void EndProfilerZone(int32 zoneID, int32 parentID, uint64 startTicks, const char *traceDetail, int32 traceBytes);
+
+// opens profiler.tracePath & starts the thread that writes events out in the background, the file's valid json once StopProfilerTrace() is called
+// (Perfetto & about:tracing are fine with the trailing "]}" being missing if the engine doesn't make it that far though)
+void StartProfilerTrace();
+void StopProfilerTrace();
+
+// starts timing a new frame (ending the last one if that hasn't happened yet), zones only get timed while "Show Profiler" is on
+void BeginProfilerFrame();
+void EndProfilerFrame();
+
+// frame time graph (& a per-zone breakdown if "Show Profiler" is 2) in the top left of the screen
+void DrawProfilerOverlay();
+
+struct ProfilerScope {
+    inline ProfilerScope(int32 zoneID)
+    {
+        this->traceDetail = NULL;
+        this->traceBytes  = -1;
+
+        if ((profiler.enabled || profiler.tracing) && zoneID >= 0) {
+            this->zoneID   = zoneID;
+            this->parentID = BeginProfilerZone(zoneID);
+            this->start    = GetProfilerTicks();
+        }
+        else {
+            this->zoneID = -1;
+        }
+    }
+    inline ~ProfilerScope()
+    {
+        if (zoneID >= 0)
+            EndProfilerZone(zoneID, parentID, start, traceDetail, traceBytes);
+    }
+
+    int32 zoneID   = -1;
+    int32 parentID = -1;
+    uint64 start   = 0;
+    // extra info for the trace event, the string gets copied so it only has to last as long as the scope does
+    const char *traceDetail;
+    int32 traceBytes;
+};
+
+#define PROFILER_CONCAT_(a, b) a##b
+#define PROFILER_CONCAT(a, b)  PROFILER_CONCAT_(a, b)
+// times everything from here to the end of the current scope
+#define PROFILE_SCOPE(name) PROFILE_SCOPE_NAMED(PROFILER_CONCAT(profilerScope, __LINE__), name)
+// same as PROFILE_SCOPE, but the scope can be given a detail string & byte count with PROFILE_DETAIL/PROFILE_BYTES
+#define PROFILE_SCOPE_NAMED(scope, name)                                                                                                       \
+    static int32 PROFILER_CONCAT(profilerZone, __LINE__) = RegisterProfilerZone(name);                                                         \
+    ProfilerScope scope(PROFILER_CONCAT(profilerZone, __LINE__))
+#define PROFILE_DETAIL(scope, detail) scope.traceDetail = detail
+#define PROFILE_BYTES(scope, bytes)   scope.traceBytes = (int32)(bytes)
+
+enum ProfilerClassCallbacks {
+    PROFILER_CLASS_UPDATE,
+    PROFILER_CLASS_LATEUPDATE,
+    PROFILER_CLASS_STATICUPDATE,
+    PROFILER_CLASS_DRAW,
+    // Mod.Super calls, these are already counted as part of whichever callback made them
+    PROFILER_CLASS_SUPER,
+    PROFILER_CLASS_CALLBACK_COUNT,
+};
+
+// the slot after the last class is for everything mods do in their MODCB_ONUPDATE/etc callbacks
+#define PROFILER_CLASS_MODCALLBACKS (OBJECT_COUNT)
+
+struct ProfilerClassStats {
+    uint64 time[PROFILER_CLASS_CALLBACK_COUNT]; // nanoseconds
+    uint32 calls[PROFILER_CLASS_CALLBACK_COUNT];
+    uint32 frameTime; // gets folded into peakTime at the end of every frame
+    uint32 peakTime;
+};
+
+// indexed the same as objectClassList, these are only tracked while "Show Profiler" is on & get reset whenever a scene loads
+extern ProfilerClassStats profilerClassStats[OBJECT_COUNT + 1];
+extern uint32 profilerClassFrames;
+
+void ResetProfilerClassStats();
+void EndProfilerClassCall(int32 classID, int32 callback, uint64 startTicks);
+const char *GetProfilerClassName(int32 classID);
+// writes every class that's been called since the scene loaded to a csv file, returns false if it couldn't be opened
+bool32 ExportProfilerClassStats(const char *filePath);
+
+struct ProfilerClassScope {
+    inline ProfilerClassScope(int32 classID, int32 callback)
+    {
+        this->classID  = profiler.enabled ? classID : -1;
+        this->callback = callback;
+        if (this->classID >= 0)
+            this->start = GetProfilerTicks();
+    }
+    inline ~ProfilerClassScope()
+    {
+        if (classID >= 0)
+            EndProfilerClassCall(classID, callback, start);
+    }
+
+    int32 classID  = -1;
+    int32 callback = 0;
+    uint64 start   = 0;
+};
+
+// charges everything from here to the end of the current scope to an object class (index into objectClassList), main thread only
+#define PROFILE_CLASS(classID, callback) ProfilerClassScope PROFILER_CONCAT(profilerClassScope, __LINE__)(classID, callback)
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_SCOPE_NAMED(scope, name)
+#define PROFILE_DETAIL(scope, detail)
+#define PROFILE_BYTES(scope, bytes)
+#define PROFILE_CLASS(classID, callback)
+
+#endif
+
+} // namespace RSDK
+
+#endif
@@ -0,0 +1,604 @@
+// NOTE: this is included straight into Drawing.cpp, same as DrawingSIMD.cpp
+
+#if RETRO_USE_DRAW_COMMANDS
+
+static DrawCommandList drawCommandLists[SCREEN_COUNT];
+DrawCommandList *RSDK::drawCommandList = &drawCommandLists[0];
+bool32 RSDK::drawCommandsPending        = false;
+
+RETRO_RENDER_TLS bool32 RSDK::drawRecording = false;
+RETRO_RENDER_TLS bool32 RSDK::drawClipTest  = false;
+
+#if RETRO_USE_RENDER_THREADS
+struct RenderJob {
+    DrawCommandList *list;
+    int32 bandID;
+};
+
+// the bands get drawn as jobs, so this is how many each screen's split into rather than actual threads
+static int32 renderThreadCount = 1;
+static bool32 parallelScreens  = false;
+
+static RenderJob renderJobs[SCREEN_COUNT][RENDERTHREAD_COUNT];
+#endif
+
+static DrawCommand *AddDrawCommand(uint8 type, int32 dataSize)
+{
+    DrawCommandList *list = drawCommandList;
+
+    dataSize = (dataSize + 0xF) & ~0xF;
+    if (list->commandCount + 2 > DRAWCOMMAND_COUNT || list->dataSize + dataSize + sizeof(list->recordedLineBuffer) > DRAWCOMMAND_DATA_SIZE)
+        FlushDrawCommands();
+
+    if (!list->commandCount) {
+        memcpy(list->startLineBuffer, gfxLineBuffer, sizeof(list->startLineBuffer));
+        memcpy(list->recordedLineBuffer, gfxLineBuffer, sizeof(list->recordedLineBuffer));
+    }
+    else if (memcmp(list->recordedLineBuffer, gfxLineBuffer, sizeof(list->recordedLineBuffer))) {
+        // SetActivePalette (or anything else writing to gfxLineBuffer) has been called since the last draw
+        DrawCommand *lineCmd = &list->commands[list->commandCount++];
+        lineCmd->type        = DRAWCMD_LINEBUFFER;
+        lineCmd->dataOffset  = list->dataSize;
+        memcpy(&list->data[list->dataSize], gfxLineBuffer, sizeof(list->recordedLineBuffer));
+        memcpy(list->recordedLineBuffer, gfxLineBuffer, sizeof(list->recordedLineBuffer));
+        list->dataSize += sizeof(list->recordedLineBuffer);
+    }
+
+    DrawCommand *cmd  = &list->commands[list->commandCount++];
+    cmd->type         = type;
+    cmd->clipBound_X1 = currentScreen->clipBound_X1;
+    cmd->clipBound_Y1 = currentScreen->clipBound_Y1;
+    cmd->clipBound_X2 = currentScreen->clipBound_X2;
+    cmd->clipBound_Y2 = currentScreen->clipBound_Y2;
+    cmd->screenPos    = currentScreen->position;
+    cmd->dataOffset   = list->dataSize;
+    list->dataSize += dataSize;
+
+    drawCommandsPending = true;
+    return cmd;
+}
+
+// runs a draw call with drawClipTest set, so we only get as far as knowing if it'd set validDraw
+static void BeginClipTest(bool32 *prevValidDraw)
+{
+    *prevValidDraw = validDraw;
+    validDraw      = false;
+    drawRecording  = false;
+    drawClipTest   = true;
+}
+
+static bool32 EndClipTest(bool32 prevValidDraw)
+{
+    bool32 drawn  = validDraw;
+    validDraw     = prevValidDraw || drawn;
+    drawRecording = true;
+    drawClipTest  = false;
+
+    return drawn;
+}
+
+static void DrawCommandBand(DrawCommandList *list, int32 bandID)
+{
+    ScreenInfo *target    = list->target;
+    int32 bandCount       = 1;
+    bool32 privateScreens = false;
+#if RETRO_USE_RENDER_THREADS
+    bandCount      = list->bandCount;
+    privateScreens = list->privateScreens;
+#endif
+    int32 bandY1 = target->size.y * bandID / bandCount;
+    int32 bandY2 = target->size.y * (bandID + 1) / bandCount;
+
+    // this can run on any thread (including the main one while it waits), so put back whatever it was doing after
+    ScreenInfo *prevScreen      = currentScreen;
+    ScanlineInfo *prevScanlines = scanlines;
+    bool32 prevValidDraw        = validDraw;
+    bool32 prevRecording        = drawRecording;
+    bool32 prevClipTest         = drawClipTest;
+    uint8 prevLineBuffer[SCREEN_YSIZE];
+    memcpy(prevLineBuffer, gfxLineBuffer, sizeof(prevLineBuffer));
+
+    // the main thread can pick up bands while it's waiting on other jobs mid-recording, the commands still need to actually be drawn
+    drawRecording = false;
+    drawClipTest  = false;
+
+    // unless it's split into bands (or drawn alongside other screens) everything just gets drawn straight onto the screen
+    ScreenInfo *screen   = target;
+    Vector2 prevPosition = target->position;
+    int32 prevClipX1     = target->clipBound_X1;
+    int32 prevClipY1     = target->clipBound_Y1;
+    int32 prevClipX2     = target->clipBound_X2;
+    int32 prevClipY2     = target->clipBound_Y2;
+
+#if RETRO_USE_RENDER_THREADS
+    int32 pitch = target->pitch;
+    if (privateScreens) {
+        if (!list->bandScreens[bandID]) {
+            list->bandScreens[bandID] = (ScreenInfo *)malloc(sizeof(ScreenInfo));
+            memset(list->bandScreens[bandID], 0, sizeof(ScreenInfo));
+        }
+
+        screen               = list->bandScreens[bandID];
+        screen->size         = target->size;
+        screen->center       = target->center;
+        screen->pitch        = target->pitch;
+        screen->waterDrawPos = target->waterDrawPos;
+        memcpy(&screen->frameBuffer[bandY1 * pitch], &target->frameBuffer[bandY1 * pitch], (bandY2 - bandY1) * pitch * sizeof(uint16));
+    }
+#endif
+
+    currentScreen = screen;
+    memcpy(gfxLineBuffer, list->startLineBuffer, sizeof(gfxLineBuffer));
+
+    for (int32 c = 0; c < list->commandCount; ++c) {
+        DrawCommand *cmd = &list->commands[c];
+        int32 *args      = cmd->args;
+        uint8 *data      = &list->data[cmd->dataOffset];
+
+        if (cmd->type == DRAWCMD_LINEBUFFER) {
+            memcpy(gfxLineBuffer, data, sizeof(gfxLineBuffer));
+            continue;
+        }
+
+        screen->position     = cmd->screenPos;
+        screen->clipBound_X1 = cmd->clipBound_X1;
+        screen->clipBound_Y1 = cmd->clipBound_Y1;
+        screen->clipBound_X2 = cmd->clipBound_X2;
+        screen->clipBound_Y2 = cmd->clipBound_Y2;
+
+        // these draw each row independently of the ones around it, so they can be clipped to the band
+        // everything else gets drawn in full & whatever lands outside the band is simply never copied back
+        bool32 rowSeparable = false;
+        switch (cmd->type) {
+            default: break;
+
+            case DRAWCMD_RECTANGLE:
+            case DRAWCMD_SPRITE:
+            case DRAWCMD_ROTOZOOM: rowSeparable = true; break;
+
+            case DRAWCMD_LAYER: rowSeparable = args[1] == LAYER_HSCROLL || args[1] == LAYER_ROTOZOOM; break;
+
+            case DRAWCMD_LAYERCACHE: rowSeparable = true; break;
+        }
+
+        if (rowSeparable && bandCount > 1) {
+            screen->clipBound_Y1 = MAX(screen->clipBound_Y1, bandY1);
+            screen->clipBound_Y2 = MIN(screen->clipBound_Y2, bandY2);
+            if (screen->clipBound_Y1 >= screen->clipBound_Y2)
+                continue;
+        }
+
+        switch (cmd->type) {
+            default: break;
+
+            case DRAWCMD_FILLSCREEN: FillScreen(args[0], args[1], args[2], args[3]); break;
+
+            case DRAWCMD_LINE: DrawLine(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]); break;
+
+            case DRAWCMD_RECTANGLE: DrawRectangle(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]); break;
+
+            case DRAWCMD_CIRCLE: DrawCircle(args[0], args[1], args[2], args[3], args[4], args[5], args[6]); break;
+
+            case DRAWCMD_CIRCLEOUTLINE: DrawCircleOutline(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7]); break;
+
+            case DRAWCMD_FACE: DrawFace((Vector2 *)data, args[0], args[1], args[2], args[3], args[4], args[5]); break;
+
+            case DRAWCMD_BLENDEDFACE: DrawBlendedFace((Vector2 *)data, (uint32 *)&((Vector2 *)data)[args[0]], args[0], args[1], args[2]); break;
+
+            case DRAWCMD_SPRITE:
+                DrawSpriteFlipped(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9]);
+                break;
+
+            case DRAWCMD_ROTOZOOM:
+                DrawSpriteRotozoom(args[0], args[1], args[2], args[3], args[4], args[5], args[6], args[7], args[8], args[9], args[10],
+                                   (int16)args[11], args[12], args[13], args[14]);
+                break;
+
+            case DRAWCMD_DEFORMED:
+                scanlines = (ScanlineInfo *)data;
+                DrawDeformedSprite(args[0], args[1], args[2]);
+                break;
+
+            case DRAWCMD_LAYER: {
+                TileLayer *layer = &tileLayers[args[0]];
+                scanlines        = (ScanlineInfo *)data;
+
+                switch (args[1]) {
+                    case LAYER_HSCROLL: DrawLayerHScroll(layer); break;
+                    case LAYER_VSCROLL: DrawLayerVScroll(layer); break;
+                    case LAYER_ROTOZOOM: DrawLayerRotozoom(layer); break;
+                    case LAYER_BASIC: DrawLayerBasic(layer); break;
+                    default: break;
+                }
+                break;
+            }
+
+#if RETRO_USE_LAYER_CACHE
+            case DRAWCMD_LAYERCACHE: DrawLayerCache(args[0], args[1]); break;
+#endif
+        }
+    }
+
+#if RETRO_USE_RENDER_THREADS
+    if (privateScreens)
+        memcpy(&target->frameBuffer[bandY1 * pitch], &screen->frameBuffer[bandY1 * pitch], (bandY2 - bandY1) * pitch * sizeof(uint16));
+#endif
+
+    if (screen == target) {
+        target->position     = prevPosition;
+        target->clipBound_X1 = prevClipX1;
+        target->clipBound_Y1 = prevClipY1;
+        target->clipBound_X2 = prevClipX2;
+        target->clipBound_Y2 = prevClipY2;
+    }
+
+    currentScreen = prevScreen;
+    scanlines     = prevScanlines;
+    validDraw     = prevValidDraw;
+    drawRecording = prevRecording;
+    drawClipTest  = prevClipTest;
+    memcpy(gfxLineBuffer, prevLineBuffer, sizeof(gfxLineBuffer));
+}
+
+#if RETRO_USE_RENDER_THREADS
+static void RunRenderJob(void *data)
+{
+    RenderJob *job = (RenderJob *)data;
+    DrawCommandBand(job->list, job->bandID);
+}
+
+static void SubmitDrawCommandList(DrawCommandList *list)
+{
+    list->submitted = true;
+    for (int32 b = 0; b < list->bandCount; ++b) {
+        RenderJob *job = &renderJobs[list - drawCommandLists][b];
+        job->list      = list;
+        job->bandID    = b;
+        SubmitJob(RunRenderJob, job, &list->bandsRemaining);
+    }
+}
+
+// the main thread doesn't just sit there while it waits, it takes bands (or any other jobs) off the queues same as the workers do
+static void WaitDrawCommandList(DrawCommandList *list) { WaitForJobCounter(&list->bandsRemaining); }
+
+static void SetupRenderThreads(int32 threadCount)
+{
+    ReleaseRenderThreads();
+
+    renderThreadCount = threadCount;
+}
+
+void RSDK::ReleaseRenderThreads()
+{
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) WaitDrawCommandList(&drawCommandLists[s]);
+
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) {
+        for (int32 b = 0; b < RENDERTHREAD_COUNT; ++b) {
+            if (drawCommandLists[s].bandScreens[b]) {
+                free(drawCommandLists[s].bandScreens[b]);
+                drawCommandLists[s].bandScreens[b] = NULL;
+            }
+        }
+    }
+
+    renderThreadCount = 1;
+}
+#endif
+
+void RSDK::BeginDrawCommands(int32 screenID)
+{
+#if RETRO_USE_RENDER_THREADS
+    if (!drawCommandsPending) {
+        int32 threadCount = CLAMP(customSettings.renderThreads, 1, RENDERTHREAD_COUNT);
+        if (threadCount != renderThreadCount)
+            SetupRenderThreads(threadCount);
+    }
+
+    // with split screen each screen gets drawn on its own while the next one is recorded, so the threads get shared out between them
+    parallelScreens = renderThreadCount > 1 && videoSettings.screenCount > 1;
+#endif
+
+    drawCommandList = &drawCommandLists[screenID];
+#if RETRO_USE_RENDER_THREADS
+    // should've been finished by the last flush, but the bands can't be reading it while it gets reset
+    WaitDrawCommandList(drawCommandList);
+    drawCommandList->submitted = false;
+#endif
+    drawCommandList->target       = currentScreen;
+    drawCommandList->commandCount = 0;
+    drawCommandList->dataSize     = 0;
+#if RETRO_USE_RENDER_THREADS
+    drawCommandList->bandCount      = parallelScreens ? MAX(renderThreadCount / videoSettings.screenCount, 1) : renderThreadCount;
+    drawCommandList->privateScreens = parallelScreens || drawCommandList->bandCount > 1;
+#endif
+
+    drawRecording = customSettings.deferDrawing;
+#if RETRO_USE_RENDER_THREADS
+    drawRecording |= renderThreadCount > 1;
+#endif
+}
+
+void RSDK::EndDrawCommands()
+{
+#if RETRO_USE_RENDER_THREADS
+    // hand the whole screen off & get started on the next one, SyncDrawCommands will wait for it if needed
+    if (parallelScreens && drawCommandList->commandCount) {
+        SubmitDrawCommandList(drawCommandList);
+        drawRecording = false;
+        return;
+    }
+#endif
+
+    FlushDrawCommands();
+    drawRecording = false;
+}
+
+void RSDK::FlushDrawGroup()
+{
+    PROFILE_SCOPE("FlushDrawGroup");
+
+#if RETRO_USE_RENDER_THREADS
+    if (parallelScreens) {
+#if RETRO_USE_MOD_LOADER
+        // mods are free to look at the framebuffer once a draw group is done, so that one has to be drawn now
+        if (modCallbackList[MODCB_ONDRAW].size())
+            FlushDrawCommands();
+#endif
+        return;
+    }
+#endif
+
+    SyncDrawCommands();
+}
+
+void RSDK::FlushDrawCommands()
+{
+    if (!drawCommandsPending)
+        return;
+
+    bool32 recording = drawRecording;
+    drawRecording    = false;
+
+#if RETRO_USE_RENDER_THREADS
+    // any screens that were handed off earlier have to be finished too, since whatever comes next might change state they rely on
+    // (that includes this one if EndDrawCommands already handed it off, in which case it's done once it's finished)
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) WaitDrawCommandList(&drawCommandLists[s]);
+
+    if (drawCommandList->commandCount && !drawCommandList->submitted) {
+        if (drawCommandList->privateScreens) {
+            SubmitDrawCommandList(drawCommandList);
+            WaitDrawCommandList(drawCommandList);
+        }
+        else {
+            DrawCommandBand(drawCommandList, 0);
+        }
+    }
+#else
+    if (drawCommandList->commandCount)
+        DrawCommandBand(drawCommandList, 0);
+#endif
+
+    drawCommandList->commandCount = 0;
+    drawCommandList->dataSize     = 0;
+#if RETRO_USE_RENDER_THREADS
+    drawCommandList->submitted = false;
+#endif
+    drawCommandsPending = false;
+    drawRecording       = recording;
+}
+
+void RSDK::RecordFillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    FillScreen(color, alphaR, alphaG, alphaB);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_FILLSCREEN, 0);
+    cmd->args[0]     = color;
+    cmd->args[1]     = alphaR;
+    cmd->args[2]     = alphaG;
+    cmd->args[3]     = alphaB;
+}
+
+void RSDK::RecordDrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
+{
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_LINE, 0);
+    cmd->args[0]     = x1;
+    cmd->args[1]     = y1;
+    cmd->args[2]     = x2;
+    cmd->args[3]     = y2;
+    cmd->args[4]     = color;
+    cmd->args[5]     = alpha;
+    cmd->args[6]     = inkEffect;
+    cmd->args[7]     = screenRelative;
+}
+
+void RSDK::RecordDrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    DrawRectangle(x, y, width, height, color, alpha, inkEffect, screenRelative);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_RECTANGLE, 0);
+    cmd->args[0]     = x;
+    cmd->args[1]     = y;
+    cmd->args[2]     = width;
+    cmd->args[3]     = height;
+    cmd->args[4]     = color;
+    cmd->args[5]     = alpha;
+    cmd->args[6]     = inkEffect;
+    cmd->args[7]     = screenRelative;
+}
+
+void RSDK::RecordDrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
+{
+    if (radius <= 0)
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_CIRCLE, 0);
+    cmd->args[0]     = x;
+    cmd->args[1]     = y;
+    cmd->args[2]     = radius;
+    cmd->args[3]     = color;
+    cmd->args[4]     = alpha;
+    cmd->args[5]     = inkEffect;
+    cmd->args[6]     = screenRelative;
+}
+
+void RSDK::RecordDrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRadius, uint32 color, int32 alpha, int32 inkEffect,
+                                   bool32 screenRelative)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    DrawCircleOutline(x, y, innerRadius, outerRadius, color, alpha, inkEffect, screenRelative);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_CIRCLEOUTLINE, 0);
+    cmd->args[0]     = x;
+    cmd->args[1]     = y;
+    cmd->args[2]     = innerRadius;
+    cmd->args[3]     = outerRadius;
+    cmd->args[4]     = color;
+    cmd->args[5]     = alpha;
+    cmd->args[6]     = inkEffect;
+    cmd->args[7]     = screenRelative;
+}
+
+void RSDK::RecordDrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32 b, int32 alpha, int32 inkEffect)
+{
+    int32 dataSize = vertCount * sizeof(Vector2);
+    if (vertCount <= 0 || dataSize > DRAWCOMMAND_DATA_SIZE / 2) {
+        // way too big to buffer, just draw it right away
+        FlushDrawCommands();
+        drawRecording = false;
+        DrawFace(vertices, vertCount, r, g, b, alpha, inkEffect);
+        drawRecording = true;
+        return;
+    }
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_FACE, dataSize);
+    cmd->args[0]     = vertCount;
+    cmd->args[1]     = r;
+    cmd->args[2]     = g;
+    cmd->args[3]     = b;
+    cmd->args[4]     = alpha;
+    cmd->args[5]     = inkEffect;
+    memcpy(&drawCommandList->data[cmd->dataOffset], vertices, dataSize);
+}
+
+void RSDK::RecordDrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, int32 alpha, int32 inkEffect)
+{
+    int32 dataSize = vertCount * (sizeof(Vector2) + sizeof(uint32));
+    if (vertCount <= 0 || dataSize > DRAWCOMMAND_DATA_SIZE / 2) {
+        FlushDrawCommands();
+        drawRecording = false;
+        DrawBlendedFace(vertices, colors, vertCount, alpha, inkEffect);
+        drawRecording = true;
+        return;
+    }
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_BLENDEDFACE, dataSize);
+    cmd->args[0]     = vertCount;
+    cmd->args[1]     = alpha;
+    cmd->args[2]     = inkEffect;
+    memcpy(&drawCommandList->data[cmd->dataOffset], vertices, vertCount * sizeof(Vector2));
+    memcpy(&drawCommandList->data[cmd->dataOffset + vertCount * sizeof(Vector2)], colors, vertCount * sizeof(uint32));
+}
+
+void RSDK::RecordDrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect,
+                                   int32 alpha, int32 sheetID)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    DrawSpriteFlipped(x, y, width, height, sprX, sprY, direction, inkEffect, alpha, sheetID);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_SPRITE, 0);
+    cmd->args[0]     = x;
+    cmd->args[1]     = y;
+    cmd->args[2]     = width;
+    cmd->args[3]     = height;
+    cmd->args[4]     = sprX;
+    cmd->args[5]     = sprY;
+    cmd->args[6]     = direction;
+    cmd->args[7]     = inkEffect;
+    cmd->args[8]     = alpha;
+    cmd->args[9]     = sheetID;
+}
+
+void RSDK::RecordDrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 width, int32 height, int32 sprX, int32 sprY, int32 scaleX,
+                                    int32 scaleY, int32 direction, int16 rotation, int32 inkEffect, int32 alpha, int32 sheetID)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    DrawSpriteRotozoom(x, y, pivotX, pivotY, width, height, sprX, sprY, scaleX, scaleY, direction, rotation, inkEffect, alpha, sheetID);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_ROTOZOOM, 0);
+    cmd->args[0]     = x;
+    cmd->args[1]     = y;
+    cmd->args[2]     = pivotX;
+    cmd->args[3]     = pivotY;
+    cmd->args[4]     = width;
+    cmd->args[5]     = height;
+    cmd->args[6]     = sprX;
+    cmd->args[7]     = sprY;
+    cmd->args[8]     = scaleX;
+    cmd->args[9]     = scaleY;
+    cmd->args[10]    = direction;
+    cmd->args[11]    = rotation;
+    cmd->args[12]    = inkEffect;
+    cmd->args[13]    = alpha;
+    cmd->args[14]    = sheetID;
+}
+
+void RSDK::RecordDrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha)
+{
+    bool32 prevValidDraw;
+    BeginClipTest(&prevValidDraw);
+    DrawDeformedSprite(sheetID, inkEffect, alpha);
+    if (!EndClipTest(prevValidDraw))
+        return;
+
+    // the deformation gets read straight out of scanlines, so grab a copy of it as it is right now
+    int32 dataSize   = MAX(currentScreen->clipBound_Y2, 0) * sizeof(ScanlineInfo);
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_DEFORMED, dataSize);
+    cmd->args[0]     = sheetID;
+    cmd->args[1]     = inkEffect;
+    cmd->args[2]     = alpha;
+    memcpy(&drawCommandList->data[cmd->dataOffset], scanlines, dataSize);
+}
+
+void RSDK::RecordDrawLayer(uint16 layerID)
+{
+    TileLayer *layer = &tileLayers[layerID];
+    if (!layer->xsize || !layer->ysize)
+        return;
+
+    // same as above, ProcessParallax/scanlineCallback just filled in scanlines for this layer
+    // vscroll layers have a scanline per column rather than per row
+    int32 lineCount  = layer->type == LAYER_VSCROLL ? currentScreen->clipBound_X2 : currentScreen->clipBound_Y2;
+    int32 dataSize   = MAX(lineCount, 0) * sizeof(ScanlineInfo);
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_LAYER, dataSize);
+    cmd->args[0]     = layerID;
+    cmd->args[1]     = layer->type;
+    memcpy(&drawCommandList->data[cmd->dataOffset], scanlines, dataSize);
+}
+
+#if RETRO_USE_LAYER_CACHE
+void RSDK::RecordDrawLayerCache(uint16 layerID, uint8 screenID)
+{
+    // everything it needs is already in the layer's cache, which stays as is until the next frame
+    DrawCommand *cmd = AddDrawCommand(DRAWCMD_LAYERCACHE, 0);
+    cmd->args[0]     = layerID;
+    cmd->args[1]     = screenID;
+}
+#endif
+#endif
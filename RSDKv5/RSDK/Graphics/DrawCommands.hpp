@@ -0,0 +1,117 @@
+#ifndef DRAWCOMMANDS_H
+#define DRAWCOMMANDS_H
+
+namespace RSDK
+{
+
+struct ScreenInfo;
+
+#if RETRO_USE_DRAW_COMMANDS
+
+#define DRAWCOMMAND_COUNT     (0x1000)
+#define DRAWCOMMAND_DATA_SIZE (0x80000)
+#if RETRO_USE_RENDER_THREADS
+#define RENDERTHREAD_COUNT (0x10)
+#endif
+
+enum DrawCommandTypes {
+    DRAWCMD_LINEBUFFER,
+    DRAWCMD_FILLSCREEN,
+    DRAWCMD_LINE,
+    DRAWCMD_RECTANGLE,
+    DRAWCMD_CIRCLE,
+    DRAWCMD_CIRCLEOUTLINE,
+    DRAWCMD_FACE,
+    DRAWCMD_BLENDEDFACE,
+    DRAWCMD_SPRITE,
+    DRAWCMD_ROTOZOOM,
+    DRAWCMD_DEFORMED,
+    DRAWCMD_LAYER,
+    DRAWCMD_LAYERCACHE,
+};
+
+// a draw call captured while recording, the args are the draw function's own params in the order they're passed
+struct DrawCommand {
+    uint8 type;
+    int32 clipBound_X1;
+    int32 clipBound_Y1;
+    int32 clipBound_X2;
+    int32 clipBound_Y2;
+    Vector2 screenPos;
+    int32 dataOffset; // offset into drawCommandData for vertices, colours, scanlines, etc
+    int32 args[15];
+};
+
+// every screen records into its own list, so one screen can be drawn while the next is still being recorded
+struct DrawCommandList {
+    DrawCommand commands[DRAWCOMMAND_COUNT];
+    alignas(16) uint8 data[DRAWCOMMAND_DATA_SIZE];
+    int32 commandCount;
+    int32 dataSize;
+    // the active palettes when the list was started & the last ones a command was recorded with
+    uint8 startLineBuffer[SCREEN_YSIZE];
+    uint8 recordedLineBuffer[SCREEN_YSIZE];
+    ScreenInfo *target;
+#if RETRO_USE_RENDER_THREADS
+    int32 bandCount;
+    JobCounter bandsRemaining;
+    bool32 privateScreens;
+    // set once the list's been handed off to be drawn, so it doesn't get drawn a second time when it's flushed
+    bool32 submitted;
+    ScreenInfo *bandScreens[RENDERTHREAD_COUNT];
+#endif
+};
+
+extern DrawCommandList *drawCommandList;
+// set while there's anything recorded that hasn't made it to the screen yet
+extern bool32 drawCommandsPending;
+
+// set while the current screen's draw calls are being recorded instead of drawn, the recorded commands are
+// replayed at the end of every draw group (or sooner if something they rely on is about to change)
+// these are per-thread, since bands of one screen get replayed while the main thread's still recording the next
+extern RETRO_RENDER_TLS bool32 drawRecording;
+// set while a draw call is being run only to see if it'd touch the screen (stops right after validDraw gets set)
+extern RETRO_RENDER_TLS bool32 drawClipTest;
+
+void BeginDrawCommands(int32 screenID);
+void EndDrawCommands();
+void FlushDrawGroup();
+void FlushDrawCommands();
+#if RETRO_USE_RENDER_THREADS
+void ReleaseRenderThreads();
+#endif
+
+// anything that changes state the recorded draws depend on (palettes, tiles, etc) needs to call this first
+inline void SyncDrawCommands()
+{
+    if (drawCommandsPending)
+        FlushDrawCommands();
+}
+
+void RecordFillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB);
+void RecordDrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative);
+void RecordDrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative);
+void RecordDrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative);
+void RecordDrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRadius, uint32 color, int32 alpha, int32 inkEffect,
+                             bool32 screenRelative);
+void RecordDrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32 b, int32 alpha, int32 inkEffect);
+void RecordDrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, int32 alpha, int32 inkEffect);
+void RecordDrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect, int32 alpha,
+                             int32 sheetID);
+void RecordDrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 width, int32 height, int32 sprX, int32 sprY, int32 scaleX,
+                              int32 scaleY, int32 direction, int16 rotation, int32 inkEffect, int32 alpha, int32 sheetID);
+void RecordDrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha);
+void RecordDrawLayer(uint16 layerID);
+#if RETRO_USE_LAYER_CACHE
+void RecordDrawLayerCache(uint16 layerID, uint8 screenID);
+#endif
+
+#else
+
+inline void SyncDrawCommands() {}
+
+#endif
+
+} // namespace RSDK
+
+#endif
@@ -141,6 +141,8 @@ const RenderVertex rsdkVertexBuffer[24] =
 #include "Vulkan/VulkanRenderDevice.cpp"
 #elif RETRO_RENDERDEVICE_EGL
 #include "EGL/EGLRenderDevice.cpp"
+#elif RETRO_RENDERDEVICE_NULL
+#include "Null/NullRenderDevice.cpp"
 #endif
 
 RenderDevice::WindowInfo RenderDevice::displayInfo;
@@ -156,7 +158,7 @@ float RSDK::dpi         = 1;
 int32 RSDK::cameraCount = 0;
 ScreenInfo RSDK::screens[SCREEN_COUNT];
 CameraInfo RSDK::cameras[CAMERA_COUNT];
-ScreenInfo *RSDK::currentScreen = NULL;
+RETRO_RENDER_TLS ScreenInfo *RSDK::currentScreen = NULL;
 
 int32 RSDK::shaderCount = 0;
 ShaderEntry RSDK::shaderList[SHADER_COUNT];
@@ -231,6 +233,9 @@ char RSDK::drawGroupNames[0x10][0x10] = {
     if (frameBufferClr != maskColor)                                                                                                                 \
         frameBufferClr = pixel;
 
+#include "SIMD/DrawingSIMD.cpp"
+#include "DrawCommands.cpp"
+
 void RSDK::RenderDeviceBase::ProcessDimming()
 {
     // Bug Details:
@@ -379,6 +384,7 @@ void RSDK::GetWindowSize(int32 *width, int32 *height) { RenderDevice::GetWindowS
 void RSDK::SetScreenSize(uint8 screenID, uint16 width, uint16 height)
 {
     if (screenID < SCREEN_COUNT) {
+        SyncDrawCommands();
         ScreenInfo *screen = &screens[screenID];
 
         screen->size.x   = width;
@@ -585,12 +591,23 @@ void RSDK::SwapDrawListEntries(uint8 drawGroup, uint16 slot1, uint16 slot2, uint
 
 void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordFillScreen(color, alphaR, alphaG, alphaB);
+        return;
+    }
+#endif
+
     alphaR = CLAMP(alphaR, 0x00, 0xFF);
     alphaG = CLAMP(alphaG, 0x00, 0xFF);
     alphaB = CLAMP(alphaB, 0x00, 0xFF);
 
     if (alphaR + alphaG + alphaB) {
         validDraw        = true;
+#if RETRO_USE_DRAW_COMMANDS
+        if (drawClipTest)
+            return;
+#endif
         uint16 clrBlendR = blendLookupTable[0x20 * alphaR + rgb32To16_B[(color >> 0x10) & 0xFF]];
         uint16 clrBlendG = blendLookupTable[0x20 * alphaG + rgb32To16_B[(color >> 0x08) & 0xFF]];
         uint16 clrBlendB = blendLookupTable[0x20 * alphaB + rgb32To16_B[(color >> 0x00) & 0xFF]];
@@ -614,6 +631,13 @@ void RSDK::FillScreen(uint32 color, int32 alphaR, int32 alphaG, int32 alphaB)
 
 void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawLine(x1, y1, x2, y2, color, alpha, inkEffect, screenRelative);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
 
@@ -1143,6 +1167,13 @@ void RSDK::DrawLine(int32 x1, int32 y1, int32 x2, int32 y2, uint32 color, int32
 }
 void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawRectangle(x, y, width, height, color, alpha, inkEffect, screenRelative);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -1194,6 +1225,10 @@ void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 col
 
     int32 pitch         = currentScreen->pitch - width;
     validDraw           = true;
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawClipTest)
+        return;
+#endif
     uint16 *frameBuffer = &currentScreen->frameBuffer[x + (y * currentScreen->pitch)];
     uint16 color16      = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
 
@@ -1313,6 +1348,13 @@ void RSDK::DrawRectangle(int32 x, int32 y, int32 width, int32 height, uint32 col
 }
 void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha, int32 inkEffect, bool32 screenRelative)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawCircle(x, y, radius, color, alpha, inkEffect, screenRelative);
+        return;
+    }
+#endif
+
     if (radius > 0) {
         switch (inkEffect) {
             default: break;
@@ -1647,6 +1689,13 @@ void RSDK::DrawCircle(int32 x, int32 y, int32 radius, uint32 color, int32 alpha,
 void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRadius, uint32 color, int32 alpha, int32 inkEffect,
                              bool32 screenRelative)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawCircleOutline(x, y, innerRadius, outerRadius, color, alpha, inkEffect, screenRelative);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -1705,6 +1754,10 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
             int32 ir2           = innerRadius * innerRadius;
             int32 or2           = outerRadius * outerRadius;
             validDraw           = true;
+#if RETRO_USE_DRAW_COMMANDS
+            if (drawClipTest)
+                return;
+#endif
             uint16 *frameBuffer = &currentScreen->frameBuffer[left + top * currentScreen->pitch];
             uint16 color16      = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
             int32 pitch         = (left + currentScreen->pitch - right);
@@ -1927,6 +1980,13 @@ void RSDK::DrawCircleOutline(int32 x, int32 y, int32 innerRadius, int32 outerRad
 
 void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32 b, int32 alpha, int32 inkEffect)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawFace(vertices, vertCount, r, g, b, alpha, inkEffect);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -2180,6 +2240,13 @@ void RSDK::DrawFace(Vector2 *vertices, int32 vertCount, int32 r, int32 g, int32
 }
 void RSDK::DrawBlendedFace(Vector2 *vertices, uint32 *colors, int32 vertCount, int32 alpha, int32 inkEffect)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawBlendedFace(vertices, colors, vertCount, alpha, inkEffect);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -2854,6 +2921,13 @@ void RSDK::DrawSprite(Animator *animator, Vector2 *position, bool32 screenRelati
 void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32 sprX, int32 sprY, int32 direction, int32 inkEffect, int32 alpha,
                              int32 sheetID)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawSpriteFlipped(x, y, width, height, sprX, sprY, direction, inkEffect, alpha, sheetID);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -2906,12 +2980,34 @@ void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32
 
     GFXSurface *surface = &gfxSurface[sheetID];
     validDraw           = true;
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawClipTest)
+        return;
+#endif
     int32 pitch         = currentScreen->pitch - width;
     int32 gfxPitch      = 0;
     uint8 *lineBuffer   = NULL;
     uint8 *pixels       = NULL;
     uint16 *frameBuffer = NULL;
 
+    SpriteRowBlitter blitRow = GetSpriteRowBlitter(inkEffect, direction);
+    if (blitRow && direction >= FLIP_NONE && direction <= FLIP_XY) {
+        int32 startX = (direction & FLIP_X) ? (widthFlip - 1 + sprX) : sprX;
+        int32 startY = (direction & FLIP_Y) ? (heightFlip - 1 + sprY) : sprY;
+        gfxPitch     = (direction & FLIP_Y) ? -surface->width : surface->width;
+        lineBuffer   = &gfxLineBuffer[y];
+        pixels       = &surface->pixels[startX + surface->width * startY];
+        frameBuffer  = &currentScreen->frameBuffer[x + currentScreen->pitch * y];
+
+        while (height--) {
+            blitRow(frameBuffer, pixels, width, fullPalette[*lineBuffer], alpha);
+            lineBuffer++;
+            frameBuffer += currentScreen->pitch;
+            pixels += gfxPitch;
+        }
+        return;
+    }
+
     switch (direction) {
         default: break;
 
@@ -3515,6 +3611,13 @@ void RSDK::DrawSpriteFlipped(int32 x, int32 y, int32 width, int32 height, int32
 void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int32 width, int32 height, int32 sprX, int32 sprY, int32 scaleX,
                               int32 scaleY, int32 direction, int16 rotation, int32 inkEffect, int32 alpha, int32 sheetID)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawSpriteRotozoom(x, y, pivotX, pivotY, width, height, sprX, sprY, scaleX, scaleY, direction, rotation, inkEffect, alpha, sheetID);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -3638,6 +3741,10 @@ void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int3
         int32 fullX         = TO_FIXED(sprX + width);
         int32 fullY         = TO_FIXED(sprY + height);
         validDraw           = true;
+#if RETRO_USE_DRAW_COMMANDS
+        if (drawClipTest)
+            return;
+#endif
         int32 fullScaleX    = (int32)((512.0 / (float)scaleX) * 512.0);
         int32 fullScaleY    = (int32)((512.0 / (float)scaleY) * 512.0);
         int32 deltaXLen     = fullScaleX * sine >> 2;
@@ -3866,6 +3973,13 @@ void RSDK::DrawSpriteRotozoom(int32 x, int32 y, int32 pivotX, int32 pivotY, int3
 
 void RSDK::DrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha)
 {
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawRecording) {
+        RecordDrawDeformedSprite(sheetID, inkEffect, alpha);
+        return;
+    }
+#endif
+
     switch (inkEffect) {
         default: break;
         case INK_ALPHA:
@@ -3890,6 +4004,10 @@ void RSDK::DrawDeformedSprite(uint16 sheetID, int32 inkEffect, int32 alpha)
     }
 
     validDraw              = true;
+#if RETRO_USE_DRAW_COMMANDS
+    if (drawClipTest)
+        return;
+#endif
     GFXSurface *surface    = &gfxSurface[sheetID];
     uint8 *pixels          = surface->pixels;
     int32 clipY1           = currentScreen->clipBound_Y1;
@@ -4250,6 +4368,7 @@ void RSDK::DrawAniTile(uint16 sheetID, uint16 tileIndex, uint16 srcX, uint16 src
 {
 
     if (sheetID < SURFACE_COUNT && tileIndex < TILE_COUNT) {
+        SyncDrawCommands();
         GFXSurface *surface = &gfxSurface[sheetID];
 
         // FLIP_NONE
@@ -4306,6 +4425,8 @@ void RSDK::DrawAniTile(uint16 sheetID, uint16 tileIndex, uint16 srcX, uint16 src
                 tilePixels += (TILE_SIZE * 2);
             }
         }
+
+        UpdateTileRowInfo(tileIndex, cnt);
     }
 }
 
@@ -4391,6 +4512,9 @@ void RSDK::DrawString(Animator *animator, Vector2 *position, String *string, int
 }
 void RSDK::DrawDevString(const char *string, int32 x, int32 y, int32 align, uint32 color)
 {
+    // writes straight to the framebuffer, so it can't be recorded
+    SyncDrawCommands();
+
     uint16 color16 = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
 
     int32 charOffset   = 0;
@@ -254,6 +254,8 @@ private:
 #include "Vulkan/VulkanRenderDevice.hpp"
 #elif RETRO_RENDERDEVICE_EGL
 #include "EGL/EGLRenderDevice.hpp"
+#elif RETRO_RENDERDEVICE_NULL
+#include "Null/NullRenderDevice.hpp"
 #endif
 
 extern DrawList drawGroups[DRAWGROUP_COUNT];
@@ -268,7 +270,7 @@ extern float dpi;
 extern int32 cameraCount;
 extern ScreenInfo screens[SCREEN_COUNT];
 extern CameraInfo cameras[CAMERA_COUNT];
-extern ScreenInfo *currentScreen;
+extern RETRO_RENDER_TLS ScreenInfo *currentScreen;
 
 extern int32 shaderCount;
 extern ShaderEntry shaderList[SHADER_COUNT];
@@ -418,6 +420,8 @@ inline void ClearGfxSurfaces()
     }
 }
 
+#include "SIMD/DrawingSIMD.hpp"
+
 #if RETRO_REV0U
 #include "Legacy/DrawingLegacy.hpp"
 #endif
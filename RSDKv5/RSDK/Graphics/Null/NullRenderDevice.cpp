@@ -0,0 +1,262 @@
+int32 RenderDevice::targetFPS          = -1;
+uint32 RenderDevice::frameLimit        = 0;
+uint32 RenderDevice::frameDumpInterval = 0;
+uint8 RenderDevice::frameDumpFormat    = FRAMEDUMP_PNG;
+char RenderDevice::frameDumpPath[0x100];
+
+uint32 RenderDevice::frameCount = 0;
+
+unsigned long long RenderDevice::targetFreq = 0;
+unsigned long long RenderDevice::curTicks   = 0;
+unsigned long long RenderDevice::prevTicks  = 0;
+
+// nanoseconds, only ever compared against each other
+static unsigned long long GetNullTicks()
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (unsigned long long)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+bool RenderDevice::Init()
+{
+    // no window, just take whatever size we were asked for
+    videoSettings.windowed = true;
+
+    PrintLog(PRINT_NORMAL, "w: %d h: %d (headless)", videoSettings.windowWidth, videoSettings.windowHeight);
+
+    if (!SetupRendering() || !AudioDevice::Init())
+        return false;
+
+    InitInputDevices();
+    return true;
+}
+
+void RenderDevice::CopyFrameBuffer()
+{
+    // the screens' frame buffers are the final output here, all that's left is to dump them if we were asked to
+    if (!frameDumpInterval || frameCount % frameDumpInterval)
+        return;
+
+    for (int32 s = 0; s < videoSettings.screenCount; ++s) DumpFrame(s);
+}
+
+void RenderDevice::FlipScreen()
+{
+    if (windowRefreshDelay > 0) {
+        windowRefreshDelay--;
+        if (!windowRefreshDelay)
+            UpdateGameWindow();
+        return;
+    }
+
+    ++frameCount;
+    if (frameLimit && frameCount >= frameLimit)
+        isRunning = false;
+}
+
+void RenderDevice::DumpFrame(int32 screenID)
+{
+    ScreenInfo *screen = &screens[screenID];
+
+    const char *ext = frameDumpFormat == FRAMEDUMP_PNG ? "png" : "rgb565";
+    char fullFilePath[0x180];
+    sprintf_s(fullFilePath, sizeof(fullFilePath), "%sframe_%06d_%d.%s", frameDumpPath, frameCount, screenID, ext);
+
+    FileIO *file = fOpen(fullFilePath, "wb");
+    if (!file) {
+        PrintLog(PRINT_NORMAL, "ERROR: couldn't open %s for writing!", fullFilePath);
+        frameDumpInterval = 0;
+        return;
+    }
+
+    uint16 *frameBuffer = screen->frameBuffer;
+    if (frameDumpFormat == FRAMEDUMP_PNG) {
+        uint8 *pixels = (uint8 *)malloc(screen->size.x * screen->size.y * 3 * sizeof(uint8));
+
+        uint8 *pixelPtr = pixels;
+        for (int32 y = 0; y < screen->size.y; ++y) {
+            for (int32 x = 0; x < screen->size.x; ++x) {
+                uint16 color = frameBuffer[x];
+                uint8 r      = (color >> 11) & 0x1F;
+                uint8 g      = (color >> 5) & 0x3F;
+                uint8 b      = (color >> 0) & 0x1F;
+                *pixelPtr++  = (r << 3) | (r >> 2);
+                *pixelPtr++  = (g << 2) | (g >> 4);
+                *pixelPtr++  = (b << 3) | (b >> 2);
+            }
+            frameBuffer += screen->pitch;
+        }
+
+        size_t size = 0;
+        void *png   = tdefl_write_image_to_png_file_in_memory(pixels, screen->size.x, screen->size.y, 3, &size);
+        if (png) {
+            fWrite(png, 1, size, file);
+            mz_free(png);
+        }
+
+        free(pixels);
+    }
+    else {
+        for (int32 y = 0; y < screen->size.y; ++y) {
+            fWrite(frameBuffer, sizeof(uint16), screen->size.x, file);
+            frameBuffer += screen->pitch;
+        }
+    }
+
+    fClose(file);
+}
+
+void RenderDevice::Release(bool32 isRefresh)
+{
+    if (!isRefresh) {
+        if (displayInfo.displays)
+            free(displayInfo.displays);
+        displayInfo.displays = NULL;
+
+        if (scanlines)
+            free(scanlines);
+        scanlines = NULL;
+    }
+}
+
+void RenderDevice::RefreshWindow()
+{
+    videoSettings.windowState = WINDOWSTATE_UNINITIALIZED;
+
+    Release(true);
+
+    if (!InitGraphicsAPI() || !InitShaders())
+        return;
+
+    videoSettings.windowState = WINDOWSTATE_ACTIVE;
+}
+
+void RenderDevice::InitFPSCap()
+{
+    int32 fps = targetFPS < 0 ? videoSettings.refreshRate : targetFPS;
+
+    targetFreq = fps > 0 ? 1000000000 / fps : 0;
+    curTicks   = 0;
+    prevTicks  = 0;
+}
+bool RenderDevice::CheckFPSCap()
+{
+    curTicks = GetNullTicks();
+    if (curTicks >= prevTicks + targetFreq)
+        return true;
+
+    return false;
+}
+void RenderDevice::UpdateFPSCap() { prevTicks = curTicks; }
+
+void RenderDevice::InitVertexBuffer()
+{
+    // nothing to draw the screens with, so there's nothing to set up
+}
+
+void RenderDevice::LoadShader(const char *fileName, bool32 linear) { PrintLog(PRINT_NORMAL, "This render device does not support shaders!"); }
+
+bool RenderDevice::InitShaders()
+{
+    for (int32 s = 0; s < SHADER_COUNT; ++s) shaderList[s].linear = true;
+
+    shaderList[0].linear   = false;
+    shaderCount            = 1;
+    videoSettings.shaderID = 0;
+
+    return true;
+}
+
+bool RenderDevice::InitGraphicsAPI()
+{
+    videoSettings.shaderSupport = false;
+
+    viewSize.x = videoSettings.pixWidth;
+    viewSize.y = videoSettings.pixHeight;
+
+    int32 screenWidth = videoSettings.pixWidth;
+#if !RETRO_USE_ORIGINAL_CODE
+    if (customSettings.maxPixWidth && screenWidth > customSettings.maxPixWidth)
+        screenWidth = customSettings.maxPixWidth;
+#endif
+    screenWidth = (screenWidth + 3) & 0xFFFFFFFC;
+
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) {
+        screens[s].size.y = videoSettings.pixHeight;
+
+        memset(&screens[s].frameBuffer, 0, sizeof(screens[s].frameBuffer));
+        SetScreenSize(s, screenWidth, screens[s].size.y);
+    }
+
+    pixelSize.x = screens[0].size.x;
+    pixelSize.y = screens[0].size.y;
+
+    textureSize.x = pixelSize.x;
+    textureSize.y = pixelSize.y;
+
+    lastShaderID = -1;
+    InitVertexBuffer();
+    engine.inFocus          = 1;
+    videoSettings.viewportX = 0;
+    videoSettings.viewportY = 0;
+    videoSettings.viewportW = 1.0 / viewSize.x;
+    videoSettings.viewportH = 1.0 / viewSize.y;
+
+    return true;
+}
+
+bool RenderDevice::SetupRendering()
+{
+    GetDisplays();
+
+    if (!InitGraphicsAPI() || !InitShaders())
+        return false;
+
+    int32 size = videoSettings.pixWidth >= SCREEN_YSIZE ? videoSettings.pixWidth : SCREEN_YSIZE;
+    scanlines  = (ScanlineInfo *)malloc(size * sizeof(ScanlineInfo));
+    memset(scanlines, 0, size * sizeof(ScanlineInfo));
+
+    videoSettings.windowState = WINDOWSTATE_ACTIVE;
+    videoSettings.dimMax      = 1.0;
+    videoSettings.dimPercent  = 1.0;
+
+    return true;
+}
+
+void RenderDevice::GetDisplays()
+{
+    // there's never anything to pick from
+    displayCount     = 0;
+    displayWidth[0]  = videoSettings.pixWidth;
+    displayHeight[0] = videoSettings.pixHeight;
+
+    videoSettings.fsWidth  = 0;
+    videoSettings.fsHeight = 0;
+}
+
+void RenderDevice::GetWindowSize(int32 *width, int32 *height)
+{
+    if (width)
+        *width = videoSettings.pixWidth;
+
+    if (height)
+        *height = videoSettings.pixHeight;
+}
+
+bool RenderDevice::ProcessEvents() { return isRunning; }
+
+void RenderDevice::SetupImageTexture(int32 width, int32 height, uint8 *imagePixels) {}
+
+void RenderDevice::SetupVideoTexture_YUV420(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                            int32 strideV)
+{
+}
+void RenderDevice::SetupVideoTexture_YUV422(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                            int32 strideV)
+{
+}
+void RenderDevice::SetupVideoTexture_YUV444(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                            int32 strideV)
+{
+}
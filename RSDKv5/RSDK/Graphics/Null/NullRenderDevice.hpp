@@ -0,0 +1,75 @@
+using ShaderEntry = ShaderEntryBase;
+
+enum FrameDumpFormats {
+    FRAMEDUMP_RAW, // RGB565, straight from the frame buffer
+    FRAMEDUMP_PNG,
+};
+
+// a render device that never opens a window, the software renderer still draws every frame into the screen buffers as usual
+// so it can be used for server-side simulation, soak tests & benchmarking
+class RenderDevice : public RenderDeviceBase
+{
+public:
+    struct WindowInfo {
+        struct {
+            int32 width;
+            int32 height;
+            int32 refresh_rate;
+        } * displays;
+    };
+    static WindowInfo displayInfo;
+
+    static bool Init();
+    static void CopyFrameBuffer();
+    static void FlipScreen();
+    static void Release(bool32 isRefresh);
+
+    static void RefreshWindow();
+    static void GetWindowSize(int32 *width, int32 *height);
+
+    static void SetupImageTexture(int32 width, int32 height, uint8 *imagePixels);
+    static void SetupVideoTexture_YUV420(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                         int32 strideV);
+    static void SetupVideoTexture_YUV422(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                         int32 strideV);
+    static void SetupVideoTexture_YUV444(int32 width, int32 height, uint8 *yPlane, uint8 *uPlane, uint8 *vPlane, int32 strideY, int32 strideU,
+                                         int32 strideV);
+
+    static bool ProcessEvents();
+
+    static void InitFPSCap();
+    static bool CheckFPSCap();
+    static void UpdateFPSCap();
+
+    static bool InitShaders();
+    static void LoadShader(const char *fileName, bool32 linear);
+
+    static inline void ShowCursor(bool32 shown) {}
+    static inline bool GetCursorPos(Vector2 *pos) { return false; };
+
+    static inline void SetWindowTitle() {}
+
+    // frames per second to run at, 0 runs every frame as soon as the last one's done & -1 uses videoSettings.refreshRate
+    static int32 targetFPS;
+    // the engine quits once this many frames have been shown, 0 runs until something else stops it
+    static uint32 frameLimit;
+    // every frameDumpInterval frames each screen gets written to frameDumpPath (as "<path>frame_<frame>_<screen>.<ext>")
+    static uint32 frameDumpInterval;
+    static uint8 frameDumpFormat;
+    static char frameDumpPath[0x100];
+
+private:
+    static bool SetupRendering();
+    static void InitVertexBuffer();
+    static bool InitGraphicsAPI();
+
+    static void GetDisplays();
+
+    static void DumpFrame(int32 screenID);
+
+    static uint32 frameCount;
+
+    static unsigned long long targetFreq;
+    static unsigned long long curTicks;
+    static unsigned long long prevTicks;
+};
@@ -16,8 +16,9 @@ uint16 RSDK::activeStageRows[PALETTE_BANK_COUNT];
 uint16 RSDK::stagePalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
 uint16 RSDK::fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
+std::atomic<uint32> RSDK::paletteVersion[PALETTE_BANK_COUNT] = { 1, 1, 1, 1, 1, 1, 1, 1 };
 
-uint8 RSDK::gfxLineBuffer[SCREEN_YSIZE];
+RETRO_RENDER_TLS uint8 RSDK::gfxLineBuffer[SCREEN_YSIZE];
 
 int32 RSDK::maskColor = 0;
 #if RETRO_REV02
@@ -35,6 +36,7 @@ void RSDK::LoadPalette(uint8 bankID, const char *filename, uint16 disabledRows)
     FileInfo info;
     InitFileInfo(&info);
     if (LoadFile(&info, fullFilePath, FMODE_RB)) {
+        SyncDrawCommands();
         for (int32 r = 0; r < 0x10; ++r) {
             if (!(disabledRows >> r & 1)) {
                 for (int32 c = 0; c < 0x10; ++c) {
@@ -48,6 +50,7 @@ void RSDK::LoadPalette(uint8 bankID, const char *filename, uint16 disabledRows)
                 Seek_Cur(&info, 0x10 * (3 * sizeof(uint8)));
             }
         }
+        ++paletteVersion[bankID];
 
         CloseFile(&info);
     }
@@ -58,6 +61,7 @@ void RSDK::BlendColors(uint8 destBankID, uint32 *srcColorsA, uint32 *srcColorsB,
     if (destBankID >= PALETTE_BANK_COUNT || !srcColorsA || !srcColorsB)
         return;
 
+    SyncDrawCommands();
     blendAmount = CLAMP(blendAmount, 0x00, 0xFF);
 
     uint8 blendA         = 0xFF - blendAmount;
@@ -73,6 +77,8 @@ void RSDK::BlendColors(uint8 destBankID, uint32 *srcColorsA, uint32 *srcColorsB,
         srcColorsB++;
         ++paletteColor;
     }
+
+    ++paletteVersion[destBankID];
 }
 #endif
 
@@ -81,6 +87,7 @@ void RSDK::SetPaletteFade(uint8 destBankID, uint8 srcBankA, uint8 srcBankB, int1
     if (destBankID >= PALETTE_BANK_COUNT || srcBankA >= PALETTE_BANK_COUNT || srcBankB >= PALETTE_BANK_COUNT)
         return;
 
+    SyncDrawCommands();
     blendAmount = CLAMP(blendAmount, 0x00, 0xFF);
     endIndex    = MIN(endIndex, 0x100);
 
@@ -101,4 +108,6 @@ void RSDK::SetPaletteFade(uint8 destBankID, uint8 srcBankA, uint8 srcBankB, int1
 
         ++paletteColor;
     }
+
+    ++paletteVersion[destBankID];
 }
\ No newline at end of file
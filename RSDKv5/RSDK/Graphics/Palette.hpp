@@ -1,6 +1,8 @@
 #ifndef PALETTE_H
 #define PALETTE_H
 
+#include <atomic>
+
 namespace RSDK
 {
 
@@ -22,8 +24,11 @@ extern uint16 activeStageRows[PALETTE_BANK_COUNT];
 extern uint16 stagePalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
 
 extern uint16 fullPalette[PALETTE_BANK_COUNT][PALETTE_BANK_SIZE];
+// bumped every time a bank's colours change, so anything built from a bank can tell when it's out of date
+// (only ever changed on the main thread, but render threads check it so it's atomic)
+extern std::atomic<uint32> paletteVersion[PALETTE_BANK_COUNT];
 
-extern uint8 gfxLineBuffer[SCREEN_YSIZE]; // Pointers to active palette
+extern RETRO_RENDER_TLS uint8 gfxLineBuffer[SCREEN_YSIZE]; // Pointers to active palette
 
 extern int32 maskColor;
 
@@ -62,16 +67,26 @@ inline uint32 GetPaletteEntry(uint8 bankID, uint8 index)
 
 inline void SetPaletteEntry(uint8 bankID, uint8 index, uint32 color)
 {
-    fullPalette[bankID][index] = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+    uint16 color16 = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
+    if (fullPalette[bankID][index] != color16) {
+        SyncDrawCommands();
+        fullPalette[bankID][index] = color16;
+        ++paletteVersion[bankID];
+    }
 }
 
 inline void SetPaletteMask(uint32 color)
 {
+    SyncDrawCommands();
     maskColor = rgb32To16_B[(color >> 0) & 0xFF] | rgb32To16_G[(color >> 8) & 0xFF] | rgb32To16_R[(color >> 16) & 0xFF];
 }
 
 #if RETRO_REV02
-inline void SetTintLookupTable(uint16 *lookupTable) { tintLookupTable = lookupTable; }
+inline void SetTintLookupTable(uint16 *lookupTable)
+{
+    SyncDrawCommands();
+    tintLookupTable = lookupTable;
+}
 
 #if RETRO_USE_MOD_LOADER && RETRO_MOD_LOADER_VER >= 2
 inline uint16 *GetTintLookupTable() { return tintLookupTable; }
@@ -84,14 +99,17 @@ inline uint16 *GetTintLookupTable() { return tintLookupTable; }
 inline void CopyPalette(uint8 sourceBank, uint8 srcBankStart, uint8 destinationBank, uint8 destBankStart, uint16 count)
 {
     if (sourceBank < PALETTE_BANK_COUNT && destinationBank < PALETTE_BANK_COUNT) {
+        SyncDrawCommands();
         for (int32 i = 0; i < count; ++i) {
             fullPalette[destinationBank][destBankStart + i] = fullPalette[sourceBank][srcBankStart + i];
         }
+        ++paletteVersion[destinationBank];
     }
 }
 
 inline void RotatePalette(uint8 bankID, uint8 startIndex, uint8 endIndex, bool32 right)
 {
+    SyncDrawCommands();
     if (right) {
         uint16 startClr = fullPalette[bankID][endIndex];
         for (int32 i = endIndex; i > startIndex; --i) fullPalette[bankID][i] = fullPalette[bankID][i - 1];
@@ -102,6 +120,8 @@ inline void RotatePalette(uint8 bankID, uint8 startIndex, uint8 endIndex, bool32
         for (int32 i = startIndex; i < endIndex; ++i) fullPalette[bankID][i] = fullPalette[bankID][i + 1];
         fullPalette[bankID][endIndex] = startClr;
     }
+
+    ++paletteVersion[bankID];
 }
 
 #if RETRO_REV02
@@ -0,0 +1,313 @@
+// NOTE: this is included straight into Drawing.cpp, since it relies on the setPixel macros & tables from there
+
+#if RETRO_SIMD_SSE2 || RETRO_SIMD_AVX2
+#include <emmintrin.h>
+#if RETRO_SIMD_AVX2
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+#elif RETRO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+int32 RSDK::simdLevel = SIMD_NONE;
+SpriteRowBlitter RSDK::spriteRowBlitters[2][INK_UNMASKED + 1];
+
+// Handles whatever's left of a row after the vector loop, this matches DrawSpriteFlipped exactly
+template <int32 inkEffect, bool flipX>
+static void BlitSpriteRowScalar(uint16 *frameBuffer, const uint8 *pixels, int32 count, const uint16 *activePalette, int32 alpha)
+{
+    const int32 step = flipX ? -1 : 1;
+
+    switch (inkEffect) {
+        default: break;
+
+        case INK_NONE:
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0)
+                    *frameBuffer = activePalette[*pixels];
+            }
+            break;
+
+        case INK_BLEND:
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0)
+                    setPixelBlend(activePalette[*pixels], *frameBuffer);
+            }
+            break;
+
+        case INK_ALPHA: {
+            uint16 *fbufferBlend = &blendLookupTable[0x20 * (0xFF - alpha)];
+            uint16 *pixelBlend   = &blendLookupTable[0x20 * alpha];
+
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0) {
+                    uint16 color = activePalette[*pixels];
+                    setPixelAlpha(color, *frameBuffer, alpha);
+                }
+            }
+            break;
+        }
+
+        case INK_ADD: {
+            uint16 *blendTablePtr = &blendLookupTable[0x20 * alpha];
+
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0) {
+                    uint16 color = activePalette[*pixels];
+                    setPixelAdditive(color, *frameBuffer);
+                }
+            }
+            break;
+        }
+
+        case INK_SUB: {
+            uint16 *subBlendTable = &subtractLookupTable[0x20 * alpha];
+
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0) {
+                    uint16 color = activePalette[*pixels];
+                    setPixelSubtractive(color, *frameBuffer);
+                }
+            }
+            break;
+        }
+
+        case INK_MASKED:
+            for (; count > 0; --count, pixels += step, ++frameBuffer) {
+                if (*pixels > 0 && *frameBuffer == maskColor)
+                    *frameBuffer = activePalette[*pixels];
+            }
+            break;
+    }
+}
+
+#if RETRO_SIMD_SSE2
+namespace RSDK
+{
+namespace SSE2
+{
+
+#define SIMD_TARGET
+
+struct SIMDOps {
+    typedef __m128i Vec;
+    enum { Width = 8 };
+
+    static inline Vec Set(int32 value) { return _mm_set1_epi16((int16)value); }
+    static inline Vec Load(const uint16 *src) { return _mm_loadu_si128((const __m128i *)src); }
+    static inline void Store(uint16 *dst, Vec value) { _mm_storeu_si128((__m128i *)dst, value); }
+
+    static inline Vec And(Vec a, Vec b) { return _mm_and_si128(a, b); }
+    static inline Vec Or(Vec a, Vec b) { return _mm_or_si128(a, b); }
+    static inline Vec Not(Vec a) { return _mm_xor_si128(a, _mm_cmpeq_epi16(a, a)); }
+    static inline Vec Add(Vec a, Vec b) { return _mm_add_epi16(a, b); }
+    static inline Vec Sub(Vec a, Vec b) { return _mm_sub_epi16(a, b); }
+    static inline Vec SubSat(Vec a, Vec b) { return _mm_subs_epu16(a, b); }
+    static inline Vec Mul(Vec a, Vec b) { return _mm_mullo_epi16(a, b); }
+    // signed, but every value that goes through here is < 0x8000
+    static inline Vec Min(Vec a, Vec b) { return _mm_min_epi16(a, b); }
+    template <int32 shift> static inline Vec Shr(Vec a) { return _mm_srli_epi16(a, shift); }
+    template <int32 shift> static inline Vec Shl(Vec a) { return _mm_slli_epi16(a, shift); }
+
+    static inline Vec CmpEq(Vec a, Vec b) { return _mm_cmpeq_epi16(a, b); }
+    static inline bool32 AllSet(Vec mask) { return _mm_movemask_epi8(mask) == 0xFFFF; }
+    static inline Vec Select(Vec mask, Vec a, Vec b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+    // SSE2 has no gather, so the palette lookups are done per lane
+    template <bool flipX> static inline void Gather(const uint8 *pixels, const uint16 *palette, Vec &indices, Vec &colors)
+    {
+        const int32 d = flipX ? -1 : 1;
+
+        indices = _mm_setr_epi16(pixels[0], pixels[d], pixels[2 * d], pixels[3 * d], pixels[4 * d], pixels[5 * d], pixels[6 * d], pixels[7 * d]);
+        colors  = _mm_setr_epi16(palette[pixels[0]], palette[pixels[d]], palette[pixels[2 * d]], palette[pixels[3 * d]], palette[pixels[4 * d]],
+                                 palette[pixels[5 * d]], palette[pixels[6 * d]], palette[pixels[7 * d]]);
+    }
+};
+
+#include "SpriteBlitKernel.hpp"
+
+#undef SIMD_TARGET
+
+} // namespace SSE2
+} // namespace RSDK
+#endif
+
+#if RETRO_SIMD_AVX2
+namespace RSDK
+{
+namespace AVX2
+{
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SIMD_TARGET
+#else
+#define SIMD_TARGET __attribute__((target("avx2")))
+#endif
+
+struct SIMDOps {
+    typedef __m256i Vec;
+    enum { Width = 16 };
+
+    SIMD_TARGET static inline Vec Set(int32 value) { return _mm256_set1_epi16((int16)value); }
+    SIMD_TARGET static inline Vec Load(const uint16 *src) { return _mm256_loadu_si256((const __m256i *)src); }
+    SIMD_TARGET static inline void Store(uint16 *dst, Vec value) { _mm256_storeu_si256((__m256i *)dst, value); }
+
+    SIMD_TARGET static inline Vec And(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+    SIMD_TARGET static inline Vec Or(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+    SIMD_TARGET static inline Vec Not(Vec a) { return _mm256_xor_si256(a, _mm256_cmpeq_epi16(a, a)); }
+    SIMD_TARGET static inline Vec Add(Vec a, Vec b) { return _mm256_add_epi16(a, b); }
+    SIMD_TARGET static inline Vec Sub(Vec a, Vec b) { return _mm256_sub_epi16(a, b); }
+    SIMD_TARGET static inline Vec SubSat(Vec a, Vec b) { return _mm256_subs_epu16(a, b); }
+    SIMD_TARGET static inline Vec Mul(Vec a, Vec b) { return _mm256_mullo_epi16(a, b); }
+    SIMD_TARGET static inline Vec Min(Vec a, Vec b) { return _mm256_min_epu16(a, b); }
+    template <int32 shift> SIMD_TARGET static inline Vec Shr(Vec a) { return _mm256_srli_epi16(a, shift); }
+    template <int32 shift> SIMD_TARGET static inline Vec Shl(Vec a) { return _mm256_slli_epi16(a, shift); }
+
+    SIMD_TARGET static inline Vec CmpEq(Vec a, Vec b) { return _mm256_cmpeq_epi16(a, b); }
+    SIMD_TARGET static inline bool32 AllSet(Vec mask) { return _mm256_movemask_epi8(mask) == -1; }
+    SIMD_TARGET static inline Vec Select(Vec mask, Vec a, Vec b) { return _mm256_blendv_epi8(b, a, mask); }
+
+    SIMD_TARGET static inline __m256i GatherColors(const uint16 *palette, __m256i indices)
+    {
+        // each lane reads 32 bits starting one entry back, which leaves palette[index] in the upper half
+        // transparent lanes (index 0) are masked out, so this never reads outside of the palette bank
+        __m256i active = _mm256_xor_si256(_mm256_cmpeq_epi32(indices, _mm256_setzero_si256()), _mm256_set1_epi32(-1));
+        __m256i colors = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)(palette - 1), indices, active, 2);
+        return _mm256_srli_epi32(colors, 16);
+    }
+
+    template <bool flipX> SIMD_TARGET static inline void Gather(const uint8 *pixels, const uint16 *palette, Vec &indices, Vec &colors)
+    {
+        __m128i bytes;
+        if (flipX) {
+            bytes = _mm_loadu_si128((const __m128i *)(pixels - 15));
+            bytes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        }
+        else {
+            bytes = _mm_loadu_si128((const __m128i *)pixels);
+        }
+
+        __m256i colorsLo = GatherColors(palette, _mm256_cvtepu8_epi32(bytes));
+        __m256i colorsHi = GatherColors(palette, _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)));
+
+        // packus works per 128-bit lane, so the middle two quadwords need swapping back into order
+        indices = _mm256_cvtepu8_epi16(bytes);
+        colors  = _mm256_permute4x64_epi64(_mm256_packus_epi32(colorsLo, colorsHi), 0xD8);
+    }
+};
+
+#include "SpriteBlitKernel.hpp"
+
+#undef SIMD_TARGET
+
+} // namespace AVX2
+} // namespace RSDK
+
+static bool32 CheckAVX2Support()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int32 info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+
+    // OSXSAVE & AVX, plus the OS actually saving the YMM registers
+    __cpuid(info, 1);
+    if ((info[2] & 0x18000000) != 0x18000000 || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if RETRO_SIMD_NEON
+namespace RSDK
+{
+namespace NEON
+{
+
+#define SIMD_TARGET
+
+struct SIMDOps {
+    typedef uint16x8_t Vec;
+    enum { Width = 8 };
+
+    static inline Vec Set(int32 value) { return vdupq_n_u16((uint16)value); }
+    static inline Vec Load(const uint16 *src) { return vld1q_u16(src); }
+    static inline void Store(uint16 *dst, Vec value) { vst1q_u16(dst, value); }
+
+    static inline Vec And(Vec a, Vec b) { return vandq_u16(a, b); }
+    static inline Vec Or(Vec a, Vec b) { return vorrq_u16(a, b); }
+    static inline Vec Not(Vec a) { return vmvnq_u16(a); }
+    static inline Vec Add(Vec a, Vec b) { return vaddq_u16(a, b); }
+    static inline Vec Sub(Vec a, Vec b) { return vsubq_u16(a, b); }
+    static inline Vec SubSat(Vec a, Vec b) { return vqsubq_u16(a, b); }
+    static inline Vec Mul(Vec a, Vec b) { return vmulq_u16(a, b); }
+    static inline Vec Min(Vec a, Vec b) { return vminq_u16(a, b); }
+    template <int32 shift> static inline Vec Shr(Vec a) { return vshrq_n_u16(a, shift); }
+    template <int32 shift> static inline Vec Shl(Vec a) { return vshlq_n_u16(a, shift); }
+
+    static inline Vec CmpEq(Vec a, Vec b) { return vceqq_u16(a, b); }
+    static inline bool32 AllSet(Vec mask)
+    {
+        uint64x2_t bits = vreinterpretq_u64_u16(mask);
+        return (vgetq_lane_u64(bits, 0) & vgetq_lane_u64(bits, 1)) == 0xFFFFFFFFFFFFFFFFULL;
+    }
+    static inline Vec Select(Vec mask, Vec a, Vec b) { return vbslq_u16(mask, a, b); }
+
+    // no gather on NEON either, the indices can at least be loaded as a vector though
+    template <bool flipX> static inline void Gather(const uint8 *pixels, const uint16 *palette, Vec &indices, Vec &colors)
+    {
+        const int32 d = flipX ? -1 : 1;
+
+        uint16 clr[8];
+        for (int32 i = 0; i < 8; ++i) clr[i] = palette[pixels[i * d]];
+
+        indices = vmovl_u8(flipX ? vrev64_u8(vld1_u8(pixels - 7)) : vld1_u8(pixels));
+        colors  = vld1q_u16(clr);
+    }
+};
+
+#include "SpriteBlitKernel.hpp"
+
+#undef SIMD_TARGET
+
+} // namespace NEON
+} // namespace RSDK
+#endif
+
+void RSDK::InitSpriteBlitters()
+{
+    memset(spriteRowBlitters, 0, sizeof(spriteRowBlitters));
+    simdLevel = SIMD_NONE;
+
+#if RETRO_SIMD_AVX2
+    if (CheckAVX2Support()) {
+        AVX2::SetupSpriteBlitters();
+        simdLevel = SIMD_AVX2;
+    }
+#endif
+
+#if RETRO_SIMD_SSE2
+    if (simdLevel == SIMD_NONE) {
+        SSE2::SetupSpriteBlitters();
+        simdLevel = SIMD_SSE2;
+    }
+#endif
+
+#if RETRO_SIMD_NEON
+    NEON::SetupSpriteBlitters();
+    simdLevel = SIMD_NEON;
+#endif
+
+    const char *levelNames[] = { "None", "SSE2", "AVX2", "NEON" };
+    PrintLog(PRINT_NORMAL, "SIMD Blitters: %s", levelNames[simdLevel]);
+}
@@ -0,0 +1,51 @@
+#ifndef DRAWING_SIMD_H
+#define DRAWING_SIMD_H
+
+// ============================
+// INSTRUCTION SETS
+// ============================
+#define RETRO_SIMD_SSE2 (0)
+#define RETRO_SIMD_AVX2 (0)
+#define RETRO_SIMD_NEON (0)
+
+#if RETRO_USE_SIMD
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#undef RETRO_SIMD_SSE2
+#define RETRO_SIMD_SSE2 (1)
+
+// AVX2 is never assumed, it's only compiled in for the runtime check to pick
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#undef RETRO_SIMD_AVX2
+#define RETRO_SIMD_AVX2 (1)
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+#undef RETRO_SIMD_NEON
+#define RETRO_SIMD_NEON (1)
+#endif
+#endif
+
+enum SIMDLevels {
+    SIMD_NONE,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_NEON,
+};
+
+// Draws a single sprite row, pixels is walked backwards when the blitter is an FLIP_X one
+typedef void (*SpriteRowBlitter)(uint16 *frameBuffer, const uint8 *pixels, int32 count, const uint16 *activePalette, int32 alpha);
+
+extern int32 simdLevel;
+extern SpriteRowBlitter spriteRowBlitters[2][INK_UNMASKED + 1];
+
+void InitSpriteBlitters();
+
+// returns NULL if there's no SIMD path for this ink effect, in which case the scalar path should be used
+inline SpriteRowBlitter GetSpriteRowBlitter(int32 inkEffect, int32 direction)
+{
+    if (inkEffect < INK_NONE || inkEffect > INK_UNMASKED)
+        return NULL;
+
+    return spriteRowBlitters[(direction & FLIP_X) ? 1 : 0][inkEffect];
+}
+
+#endif // !DRAWING_SIMD_H
@@ -0,0 +1,111 @@
+// Generic sprite row kernel, this gets included once per instruction set (see DrawingSIMD.cpp)
+// SIMDOps (the vector type & its ops) and SIMD_TARGET must be defined before including this
+
+template <int32 inkEffect>
+SIMD_TARGET static inline SIMDOps::Vec BlendPixels(SIMDOps::Vec color, SIMDOps::Vec dst, SIMDOps::Vec alpha, SIMDOps::Vec invAlpha)
+{
+    typedef SIMDOps::Vec Vec;
+
+    switch (inkEffect) {
+        default: return color;
+
+        case INK_BLEND: {
+            Vec blendMask = SIMDOps::Set(0x7BEF);
+            return SIMDOps::Add(SIMDOps::And(SIMDOps::Shr<1>(color), blendMask), SIMDOps::And(SIMDOps::Shr<1>(dst), blendMask));
+        }
+
+        // (value * alpha) >> 8 is what blendLookupTable holds, so the tables can be skipped entirely
+        case INK_ALPHA: {
+            Vec mask5 = SIMDOps::Set(0x1F);
+
+            Vec R = SIMDOps::Add(SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Shr<11>(dst), invAlpha)),
+                                 SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Shr<11>(color), alpha)));
+            Vec G = SIMDOps::Add(SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(SIMDOps::Shr<6>(dst), mask5), invAlpha)),
+                                 SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(SIMDOps::Shr<6>(color), mask5), alpha)));
+            Vec B = SIMDOps::Add(SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(dst, mask5), invAlpha)),
+                                 SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(color, mask5), alpha)));
+
+            return SIMDOps::Or(SIMDOps::Or(SIMDOps::Shl<11>(R), SIMDOps::Shl<6>(G)), B);
+        }
+
+        case INK_ADD: {
+            Vec mask5 = SIMDOps::Set(0x1F);
+            Vec maskG = SIMDOps::Set(0x7E0);
+
+            Vec R = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Shr<11>(color), alpha));
+            Vec G = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(SIMDOps::Shr<6>(color), mask5), alpha));
+            Vec B = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::And(color, mask5), alpha));
+
+            R = SIMDOps::Min(SIMDOps::Add(R, SIMDOps::Shr<11>(dst)), mask5);
+            G = SIMDOps::Min(SIMDOps::Add(SIMDOps::Shl<6>(G), SIMDOps::And(dst, maskG)), maskG);
+            B = SIMDOps::Min(SIMDOps::Add(B, SIMDOps::And(dst, mask5)), mask5);
+
+            return SIMDOps::Or(SIMDOps::Or(SIMDOps::Shl<11>(R), G), B);
+        }
+
+        // subtractLookupTable holds (alpha * (0x1F - value)) >> 8
+        case INK_SUB: {
+            Vec mask5 = SIMDOps::Set(0x1F);
+            Vec maskG = SIMDOps::Set(0x7E0);
+
+            Vec R = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Sub(mask5, SIMDOps::Shr<11>(color)), alpha));
+            Vec G = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Sub(mask5, SIMDOps::And(SIMDOps::Shr<6>(color), mask5)), alpha));
+            Vec B = SIMDOps::Shr<8>(SIMDOps::Mul(SIMDOps::Sub(mask5, SIMDOps::And(color, mask5)), alpha));
+
+            R = SIMDOps::SubSat(SIMDOps::Shr<11>(dst), R);
+            G = SIMDOps::SubSat(SIMDOps::And(dst, maskG), SIMDOps::Shl<6>(G));
+            B = SIMDOps::SubSat(SIMDOps::And(dst, mask5), B);
+
+            return SIMDOps::Or(SIMDOps::Or(SIMDOps::Shl<11>(R), G), B);
+        }
+    }
+}
+
+template <int32 inkEffect, bool flipX>
+SIMD_TARGET static void BlitSpriteRow(uint16 *frameBuffer, const uint8 *pixels, int32 count, const uint16 *activePalette, int32 alpha)
+{
+    typedef SIMDOps::Vec Vec;
+
+    Vec zero     = SIMDOps::Set(0);
+    Vec alphaVec = SIMDOps::Set(alpha & 0xFF);
+    Vec invAlpha = SIMDOps::Set(0xFF - (alpha & 0xFF));
+    Vec maskVec  = SIMDOps::Set(maskColor);
+
+    while (count >= SIMDOps::Width) {
+        Vec indices, colors;
+        SIMDOps::Gather<flipX>(pixels, activePalette, indices, colors);
+
+        // index 0 is always transparent, those lanes keep whatever's in the framebuffer
+        Vec transparent = SIMDOps::CmpEq(indices, zero);
+        if (!SIMDOps::AllSet(transparent)) {
+            Vec dst = SIMDOps::Load(frameBuffer);
+            if (inkEffect == INK_MASKED)
+                transparent = SIMDOps::Or(transparent, SIMDOps::Not(SIMDOps::CmpEq(dst, maskVec)));
+
+            SIMDOps::Store(frameBuffer, SIMDOps::Select(transparent, dst, BlendPixels<inkEffect>(colors, dst, alphaVec, invAlpha)));
+        }
+
+        frameBuffer += SIMDOps::Width;
+        pixels += flipX ? -SIMDOps::Width : SIMDOps::Width;
+        count -= SIMDOps::Width;
+    }
+
+    BlitSpriteRowScalar<inkEffect, flipX>(frameBuffer, pixels, count, activePalette, alpha);
+}
+
+static void SetupSpriteBlitters()
+{
+    spriteRowBlitters[0][INK_NONE]   = BlitSpriteRow<INK_NONE, false>;
+    spriteRowBlitters[0][INK_BLEND]  = BlitSpriteRow<INK_BLEND, false>;
+    spriteRowBlitters[0][INK_ALPHA]  = BlitSpriteRow<INK_ALPHA, false>;
+    spriteRowBlitters[0][INK_ADD]    = BlitSpriteRow<INK_ADD, false>;
+    spriteRowBlitters[0][INK_SUB]    = BlitSpriteRow<INK_SUB, false>;
+    spriteRowBlitters[0][INK_MASKED] = BlitSpriteRow<INK_MASKED, false>;
+
+    spriteRowBlitters[1][INK_NONE]   = BlitSpriteRow<INK_NONE, true>;
+    spriteRowBlitters[1][INK_BLEND]  = BlitSpriteRow<INK_BLEND, true>;
+    spriteRowBlitters[1][INK_ALPHA]  = BlitSpriteRow<INK_ALPHA, true>;
+    spriteRowBlitters[1][INK_ADD]    = BlitSpriteRow<INK_ADD, true>;
+    spriteRowBlitters[1][INK_SUB]    = BlitSpriteRow<INK_SUB, true>;
+    spriteRowBlitters[1][INK_MASKED] = BlitSpriteRow<INK_MASKED, true>;
+}
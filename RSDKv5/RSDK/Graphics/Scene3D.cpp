@@ -9,7 +9,7 @@ using namespace RSDK;
 Model RSDK::modelList[MODEL_COUNT];
 Scene3D RSDK::scene3DList[SCENE3D_COUNT];
 
-ScanEdge RSDK::scanEdgeBuffer[SCREEN_YSIZE * 2];
+RETRO_RENDER_TLS ScanEdge RSDK::scanEdgeBuffer[SCREEN_YSIZE * 2];
 
 enum ModelFlags {
     MODEL_NOFLAGS     = 0,
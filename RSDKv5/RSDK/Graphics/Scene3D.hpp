@@ -128,7 +128,7 @@ struct Scene3D {
 extern Model modelList[MODEL_COUNT];
 extern Scene3D scene3DList[SCENE3D_COUNT];
 
-extern ScanEdge scanEdgeBuffer[SCREEN_YSIZE * 2];
+extern RETRO_RENDER_TLS ScanEdge scanEdgeBuffer[SCREEN_YSIZE * 2];
 
 void ProcessScanEdge(int32 x1, int32 y1, int32 x2, int32 y2);
 void ProcessScanEdgeClr(uint32 c1, uint32 c2, int32 x1, int32 y1, int32 x2, int32 y2);
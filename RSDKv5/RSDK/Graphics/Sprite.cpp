@@ -905,6 +905,9 @@ bool32 RSDK::ImageTGA::Load(const char *fileName, bool32 loadHeader)
 
 uint16 RSDK::LoadSpriteSheet(const char *filename, uint8 scope)
 {
+    PROFILE_SCOPE_NAMED(profilerScope, "LoadSpriteSheet");
+    PROFILE_DETAIL(profilerScope, filename);
+
     char fullFilePath[0x100];
     sprintf_s(fullFilePath, sizeof(fullFilePath), "Data/Sprites/%s", filename);
 
@@ -52,6 +52,8 @@ int32 RSDK::gamePadCount               = 0;
 #include "Paddleboat/PDBInputDevice.cpp"
 #endif
 
+#include "InputRecording.cpp"
+
 void RSDK::RemoveInputDevice(InputDevice *targetDevice)
 {
     if (targetDevice) {
@@ -195,6 +197,12 @@ void RSDK::ProcessInput()
 {
     ClearInput();
 
+#if RETRO_USE_INPUT_RECORDING
+    // the recorded frame already has everything below applied, the devices don't get a say
+    if (inputRecording.mode == INPUTRECORDING_REPLAY && ReplayInputFrame())
+        return;
+#endif
+
     bool32 anyPress = false;
     for (int32 i = 0; i < inputDeviceCount; ++i) {
         if (inputDeviceList[i]) {
@@ -308,10 +316,17 @@ void RSDK::ProcessInput()
             }
         }
     }
+
+#if RETRO_USE_INPUT_RECORDING
+    if (inputRecording.mode == INPUTRECORDING_RECORD)
+        RecordInputFrame();
+#endif
 }
 
 void RSDK::ProcessInputDevices()
 {
+    PROFILE_SCOPE("ProcessInputDevices");
+
 #if RETRO_INPUTDEVICE_NX
     SKU::ProcessNXInputDevices();
 #endif
@@ -0,0 +1,339 @@
+// NOTE: this is included straight into Input.cpp, same as the input devices
+
+#if RETRO_USE_INPUT_RECORDING
+
+InputRecording RSDK::inputRecording;
+
+static FileIO *inputRecordingFile = NULL;
+
+static uint8 inputFrame[INPUTRECORDING_FRAME_SIZE];
+static uint8 prevInputFrame[INPUTRECORDING_FRAME_SIZE];
+static uint16 inputFrameSize     = 0;
+static uint16 prevInputFrameSize = 0;
+
+// every InputState ProcessInput() updates for a controller, always in the same order so they can be packed into bits
+static int32 GetRecordedInputStates(int32 c, InputState **states)
+{
+    int32 count = 0;
+
+    states[count++] = &controller[c].keyUp;
+    states[count++] = &controller[c].keyDown;
+    states[count++] = &controller[c].keyLeft;
+    states[count++] = &controller[c].keyRight;
+    states[count++] = &controller[c].keyA;
+    states[count++] = &controller[c].keyB;
+    states[count++] = &controller[c].keyC;
+    states[count++] = &controller[c].keyX;
+    states[count++] = &controller[c].keyY;
+    states[count++] = &controller[c].keyZ;
+    states[count++] = &controller[c].keyStart;
+    states[count++] = &controller[c].keySelect;
+
+    states[count++] = &stickL[c].keyUp;
+    states[count++] = &stickL[c].keyDown;
+    states[count++] = &stickL[c].keyLeft;
+    states[count++] = &stickL[c].keyRight;
+
+#if RETRO_REV02
+    states[count++] = &stickL[c].keyStick;
+
+    states[count++] = &stickR[c].keyUp;
+    states[count++] = &stickR[c].keyDown;
+    states[count++] = &stickR[c].keyLeft;
+    states[count++] = &stickR[c].keyRight;
+    states[count++] = &stickR[c].keyStick;
+
+    states[count++] = &triggerL[c].keyBumper;
+    states[count++] = &triggerL[c].keyTrigger;
+    states[count++] = &triggerR[c].keyBumper;
+    states[count++] = &triggerR[c].keyTrigger;
+#else
+    states[count++] = &controller[c].keyStickL;
+    states[count++] = &controller[c].keyStickR;
+
+    states[count++] = &controller[c].keyBumperL;
+    states[count++] = &controller[c].keyTriggerL;
+    states[count++] = &controller[c].keyBumperR;
+    states[count++] = &controller[c].keyTriggerR;
+#endif
+
+    return count;
+}
+
+static int32 GetRecordedAnalogValues(int32 c, float **values)
+{
+    int32 count = 0;
+
+#if RETRO_REV02
+    values[count++] = &stickL[c].hDelta;
+    values[count++] = &stickL[c].vDelta;
+    values[count++] = &stickR[c].hDelta;
+    values[count++] = &stickR[c].vDelta;
+
+    values[count++] = &triggerL[c].bumperDelta;
+    values[count++] = &triggerL[c].triggerDelta;
+    values[count++] = &triggerR[c].bumperDelta;
+    values[count++] = &triggerR[c].triggerDelta;
+#else
+    values[count++] = &stickL[c].triggerDeltaL;
+    values[count++] = &stickL[c].triggerDeltaR;
+    values[count++] = &stickL[c].hDeltaL;
+    values[count++] = &stickL[c].vDeltaL;
+    values[count++] = &stickL[c].hDeltaR;
+    values[count++] = &stickL[c].vDeltaR;
+#endif
+
+    return count;
+}
+
+static inline void WriteInputFrameData(const void *data, int32 size)
+{
+    memcpy(&inputFrame[inputFrameSize], data, size);
+    inputFrameSize += size;
+}
+
+static inline bool32 ReadInputFrameData(void *data, int32 size, int32 *pos)
+{
+    // the frame came from a file, so never read past what it actually had
+    if (*pos + size > prevInputFrameSize)
+        return false;
+
+    memcpy(data, &prevInputFrame[*pos], size);
+    *pos += size;
+    return true;
+}
+
+static void PackInputFrame()
+{
+    inputFrameSize = 0;
+
+    // nothing's assigned while replaying, so the slots have to come along too or the game will think the controllers got unplugged
+    WriteInputFrameData(inputSlots, sizeof(inputSlots));
+
+    InputState *states[32];
+    float *values[8];
+    for (int32 c = 0; c <= PLAYER_COUNT; ++c) {
+        int32 stateCount = GetRecordedInputStates(c, states);
+
+        uint64 buttons = 0;
+        for (int32 i = 0; i < stateCount; ++i) {
+            if (states[i]->down)
+                buttons |= (uint64)1 << (i << 1);
+            if (states[i]->press)
+                buttons |= (uint64)1 << ((i << 1) + 1);
+        }
+        WriteInputFrameData(&buttons, sizeof(buttons));
+
+        int32 valueCount = GetRecordedAnalogValues(c, values);
+        for (int32 i = 0; i < valueCount; ++i) WriteInputFrameData(values[i], sizeof(float));
+    }
+
+    uint8 touchCount = touchInfo.count < 0x10 ? touchInfo.count : 0x10;
+    WriteInputFrameData(&touchCount, sizeof(touchCount));
+    for (int32 t = 0; t < touchCount; ++t) {
+        uint8 down = touchInfo.down[t] ? 1 : 0;
+        WriteInputFrameData(&touchInfo.x[t], sizeof(float));
+        WriteInputFrameData(&touchInfo.y[t], sizeof(float));
+        WriteInputFrameData(&down, sizeof(down));
+    }
+
+#if !RETRO_REV02
+    uint8 touchFlags = (touchInfo.pauseHold ? 1 : 0) | (touchInfo.pausePress ? 2 : 0) | (touchInfo.anyKeyHold ? 4 : 0) | (touchInfo.anyKeyPress ? 8 : 0);
+    WriteInputFrameData(&touchFlags, sizeof(touchFlags));
+#endif
+}
+
+static bool32 UnpackInputFrame()
+{
+    int32 pos = 0;
+
+    if (!ReadInputFrameData(inputSlots, sizeof(inputSlots), &pos))
+        return false;
+
+    InputState *states[32];
+    float *values[8];
+    for (int32 c = 0; c <= PLAYER_COUNT; ++c) {
+        int32 stateCount = GetRecordedInputStates(c, states);
+
+        uint64 buttons = 0;
+        if (!ReadInputFrameData(&buttons, sizeof(buttons), &pos))
+            return false;
+
+        for (int32 i = 0; i < stateCount; ++i) {
+            states[i]->down  = (buttons >> (i << 1)) & 1;
+            states[i]->press = (buttons >> ((i << 1) + 1)) & 1;
+        }
+
+        int32 valueCount = GetRecordedAnalogValues(c, values);
+        for (int32 i = 0; i < valueCount; ++i) {
+            if (!ReadInputFrameData(values[i], sizeof(float), &pos))
+                return false;
+        }
+    }
+
+    // PackInputFrame never writes more than 0x10 touches, so anything bigger means the file's bad
+    uint8 touchCount = 0;
+    if (!ReadInputFrameData(&touchCount, sizeof(touchCount), &pos) || touchCount > 0x10)
+        return false;
+
+    touchInfo.count = touchCount;
+    for (int32 t = 0; t < touchCount; ++t) {
+        uint8 down = 0;
+        if (!ReadInputFrameData(&touchInfo.x[t], sizeof(float), &pos) || !ReadInputFrameData(&touchInfo.y[t], sizeof(float), &pos)
+            || !ReadInputFrameData(&down, sizeof(down), &pos))
+            return false;
+
+        touchInfo.down[t] = down;
+    }
+
+#if !RETRO_REV02
+    uint8 touchFlags = 0;
+    if (!ReadInputFrameData(&touchFlags, sizeof(touchFlags), &pos))
+        return false;
+
+    touchInfo.pauseHold   = (touchFlags & 1) != 0;
+    touchInfo.pausePress  = (touchFlags & 2) != 0;
+    touchInfo.anyKeyHold  = (touchFlags & 4) != 0;
+    touchInfo.anyKeyPress = (touchFlags & 8) != 0;
+#endif
+
+    // leftover bytes mean the frame was packed with a different layout than ours
+    return pos == prevInputFrameSize;
+}
+
+void RSDK::InitInputRecording()
+{
+    if (inputRecording.mode == INPUTRECORDING_NONE)
+        return;
+
+    inputRecording.frame = 0;
+    inputFrameSize       = 0;
+    prevInputFrameSize   = 0;
+
+    uint32 signature = RSDK_SIGNATURE_RPLY;
+    uint8 version    = INPUTRECORDING_VERSION;
+    uint8 revision   = RETRO_REVISION;
+
+    char sceneFolder[0x10];
+    char sceneID[0x10];
+    uint8 filter = 0;
+
+    if (inputRecording.mode == INPUTRECORDING_RECORD) {
+        inputRecordingFile = fOpen(inputRecording.filePath, "wb");
+        if (!inputRecordingFile) {
+            PrintLog(PRINT_NORMAL, "ERROR: couldn't open input recording %s for writing!", inputRecording.filePath);
+            inputRecording.mode = INPUTRECORDING_NONE;
+            return;
+        }
+
+        inputRecording.randSeed = (uint32)time(NULL);
+
+        memcpy(sceneFolder, currentSceneFolder, sizeof(sceneFolder));
+        memcpy(sceneID, currentSceneID, sizeof(sceneID));
+#if RETRO_REV02
+        filter = sceneInfo.filter;
+#endif
+
+        fWrite(&signature, sizeof(uint32), 1, inputRecordingFile);
+        fWrite(&version, sizeof(uint8), 1, inputRecordingFile);
+        fWrite(&revision, sizeof(uint8), 1, inputRecordingFile);
+        fWrite(&inputRecording.randSeed, sizeof(uint32), 1, inputRecordingFile);
+        fWrite(sceneFolder, sizeof(sceneFolder), 1, inputRecordingFile);
+        fWrite(sceneID, sizeof(sceneID), 1, inputRecordingFile);
+        fWrite(&filter, sizeof(uint8), 1, inputRecordingFile);
+
+        PrintLog(PRINT_NORMAL, "Recording input to %s", inputRecording.filePath);
+    }
+    else {
+        inputRecordingFile = fOpen(inputRecording.filePath, "rb");
+        if (!inputRecordingFile) {
+            PrintLog(PRINT_NORMAL, "ERROR: couldn't open input recording %s!", inputRecording.filePath);
+            inputRecording.mode = INPUTRECORDING_NONE;
+            return;
+        }
+
+        fRead(&signature, sizeof(uint32), 1, inputRecordingFile);
+        fRead(&version, sizeof(uint8), 1, inputRecordingFile);
+        fRead(&revision, sizeof(uint8), 1, inputRecordingFile);
+        if (signature != RSDK_SIGNATURE_RPLY || version != INPUTRECORDING_VERSION || revision != RETRO_REVISION) {
+            PrintLog(PRINT_NORMAL, "ERROR: %s isn't an input recording this engine can play back!", inputRecording.filePath);
+            ReleaseInputRecording();
+            return;
+        }
+
+        fRead(&inputRecording.randSeed, sizeof(uint32), 1, inputRecordingFile);
+        fRead(sceneFolder, sizeof(sceneFolder), 1, inputRecordingFile);
+        fRead(sceneID, sizeof(sceneID), 1, inputRecordingFile);
+        fRead(&filter, sizeof(uint8), 1, inputRecordingFile);
+
+        sceneFolder[sizeof(sceneFolder) - 1] = 0;
+        sceneID[sizeof(sceneID) - 1]         = 0;
+        memcpy(currentSceneFolder, sceneFolder, sizeof(sceneFolder));
+        memcpy(currentSceneID, sceneID, sizeof(sceneID));
+#if RETRO_REV02
+        sceneInfo.filter = filter;
+#endif
+
+        PrintLog(PRINT_NORMAL, "Replaying input from %s", inputRecording.filePath);
+    }
+}
+
+void RSDK::RecordInputFrame()
+{
+    PackInputFrame();
+
+    uint8 changed = inputFrameSize != prevInputFrameSize || memcmp(inputFrame, prevInputFrame, inputFrameSize) != 0;
+    fWrite(&changed, sizeof(uint8), 1, inputRecordingFile);
+    if (changed) {
+        fWrite(&inputFrameSize, sizeof(uint16), 1, inputRecordingFile);
+        fWrite(inputFrame, sizeof(uint8), inputFrameSize, inputRecordingFile);
+
+        memcpy(prevInputFrame, inputFrame, inputFrameSize);
+        prevInputFrameSize = inputFrameSize;
+    }
+
+    inputRecording.frame++;
+}
+
+bool32 RSDK::ReplayInputFrame()
+{
+    uint8 changed = false;
+    bool32 valid  = fRead(&changed, sizeof(uint8), 1, inputRecordingFile) == 1;
+
+    if (valid && changed) {
+        valid = fRead(&prevInputFrameSize, sizeof(uint16), 1, inputRecordingFile) == 1 && prevInputFrameSize <= INPUTRECORDING_FRAME_SIZE;
+        valid = valid && fRead(prevInputFrame, sizeof(uint8), prevInputFrameSize, inputRecordingFile) == prevInputFrameSize;
+    }
+
+    // the first frame always has data, so this only happens if the file's empty or cut off
+    if (valid && !prevInputFrameSize)
+        valid = false;
+
+    if (!valid) {
+        PrintLog(PRINT_NORMAL, "Input replay finished after %d frames", inputRecording.frame);
+        ReleaseInputRecording();
+        RenderDevice::isRunning = false;
+        return false;
+    }
+
+    if (!UnpackInputFrame()) {
+        PrintLog(PRINT_NORMAL, "ERROR: input replay frame %d is corrupt, stopping playback", inputRecording.frame);
+        ReleaseInputRecording();
+        RenderDevice::isRunning = false;
+        return false;
+    }
+
+    inputRecording.frame++;
+    return true;
+}
+
+void RSDK::ReleaseInputRecording()
+{
+    if (inputRecordingFile)
+        fClose(inputRecordingFile);
+    inputRecordingFile = NULL;
+
+    inputRecording.mode = INPUTRECORDING_NONE;
+}
+
+#endif
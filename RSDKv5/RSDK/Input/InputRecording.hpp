@@ -0,0 +1,43 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+namespace RSDK
+{
+
+#if RETRO_USE_INPUT_RECORDING
+
+#define RSDK_SIGNATURE_RPLY (0x594C5052) // "RPLY"
+
+#define INPUTRECORDING_VERSION    (1)
+#define INPUTRECORDING_FRAME_SIZE (0x400)
+
+enum InputRecordingModes {
+    INPUTRECORDING_NONE,
+    INPUTRECORDING_RECORD,
+    INPUTRECORDING_REPLAY,
+};
+
+// set up by the "recordinput=" & "replayinput=" args
+struct InputRecording {
+    uint8 mode;
+    char filePath[0x100];
+    // both modes force the rng to this seed once the engine's set up, so the run goes the same way every time
+    uint32 randSeed;
+    uint32 frame;
+};
+
+extern InputRecording inputRecording;
+
+// opens the recording & reads/writes the header, replays also restore the scene selection the recording was started with
+void InitInputRecording();
+// writes the input state ProcessInput() just produced, frames that didn't change from the last one only take up a byte
+void RecordInputFrame();
+// overwrites the input state with the next recorded frame, returns false (& quits the engine) once the recording runs out
+bool32 ReplayInputFrame();
+void ReleaseInputRecording();
+
+#endif
+
+} // namespace RSDK
+
+#endif
@@ -1,7 +1,17 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if !RETRO_USE_ORIGINAL_CODE
+#if RETRO_SIMD_SSE2
+#include <emmintrin.h>
+#elif RETRO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 using namespace RSDK;
 
+#include "CollisionKernel.hpp"
+
 #if RETRO_REV0U
 #include "Legacy/CollisionLegacy.cpp"
 #endif
@@ -203,9 +213,158 @@ void RSDK::CopyCollisionMask(uint16 dst, uint16 src, uint8 cPlane, uint8 cMode)
             memcpy(dstMask->rWallMasks, srcMask->rWallMasks, sizeof(uint8) * TILE_SIZE);
             break;
     }
+
+#if RETRO_USE_SOLIDITY_BITMAPS
+    UpdateTileHeightFields(cPlane, dst & 0x3FF);
+    UpdateTileHeightFields(cPlane, (dst & 0x3FF) * FLIP_X);
+    UpdateTileHeightFields(cPlane, (dst & 0x3FF) * FLIP_Y);
+    UpdateTileHeightFields(cPlane, (dst & 0x3FF) * FLIP_XY);
+#endif
+}
+#endif
+
+#if RETRO_USE_SOLIDITY_BITMAPS
+static inline uint64 GetSolidityBits(TileLayerSolidity *solidity, int32 solid, int32 blockX, int32 blockY)
+{
+    if (blockX < 0 || blockY < 0 || blockX >= solidity->blockCountX || blockY >= solidity->blockCountY)
+        return 0;
+
+    uint64 *block = &solidity->blocks[(blockX + blockY * solidity->blockCountX) * SOLIDITY_FLAG_COUNT];
+    uint64 bits   = 0;
+    for (int32 f = 0; f < SOLIDITY_FLAG_COUNT; ++f) {
+        if (solid & (1 << (12 + f)))
+            bits |= block[f];
+    }
+    return bits;
+}
+
+// returns false if none of the 3 tiles going down from (tileX, tileY) have any of the "solid" flags, so a sensor can skip over them
+static inline bool32 CheckSolidColumn(uint16 layerID, int32 solid, int32 tileX, int32 tileY)
+{
+    TileLayerSolidity *solidity = &layerSolidity[layerID];
+    if (!solidity->blocks || solidity->shared || solidity->layout != tileLayers[layerID].layout)
+        return true;
+
+    int32 row     = tileY & SOLIDITY_BLOCK_MASK;
+    uint64 column = 0x0101010101010101ULL << (tileX & SOLIDITY_BLOCK_MASK);
+    int32 blockX  = tileX >> SOLIDITY_BLOCK_SHIFT;
+    int32 blockY  = tileY >> SOLIDITY_BLOCK_SHIFT;
+
+    if (GetSolidityBits(solidity, solid, blockX, blockY) & column & (0xFFFFFFULL << (row << 3)))
+        return true;
+
+    // it only spills into the next block down if it starts on one of the last 2 rows
+    return row > 5 && (GetSolidityBits(solidity, solid, blockX, blockY + 1) & column & (0xFFFFFFULL >> ((8 - row) << 3)));
+}
+
+// same as CheckSolidColumn, but for the 3 tiles going right from (tileX, tileY)
+static inline bool32 CheckSolidRow(uint16 layerID, int32 solid, int32 tileX, int32 tileY)
+{
+    TileLayerSolidity *solidity = &layerSolidity[layerID];
+    if (!solidity->blocks || solidity->shared || solidity->layout != tileLayers[layerID].layout)
+        return true;
+
+    int32 column = tileX & SOLIDITY_BLOCK_MASK;
+    int32 shift  = (tileY & SOLIDITY_BLOCK_MASK) << 3;
+    int32 blockX = tileX >> SOLIDITY_BLOCK_SHIFT;
+    int32 blockY = tileY >> SOLIDITY_BLOCK_SHIFT;
+
+    if (GetSolidityBits(solidity, solid, blockX, blockY) & ((uint64)((0x7 << column) & 0xFF) << shift))
+        return true;
+
+    return column > 5 && (GetSolidityBits(solidity, solid, blockX + 1, blockY) & ((uint64)(0x7 >> (8 - column)) << shift));
+}
+
+// returns false if there's nothing with any of the "solid" flags anywhere in the tile rect, edges included
+static bool32 CheckSolidRect(uint16 layerID, int32 solid, int32 left, int32 top, int32 right, int32 bottom)
+{
+    TileLayerSolidity *solidity = &layerSolidity[layerID];
+    if (!solidity->blocks || solidity->shared || solidity->layout != tileLayers[layerID].layout)
+        return true;
+
+    left   = MAX(left, 0);
+    top    = MAX(top, 0);
+    right  = MIN(right, (solidity->blockCountX << SOLIDITY_BLOCK_SHIFT) - 1);
+    bottom = MIN(bottom, (solidity->blockCountY << SOLIDITY_BLOCK_SHIFT) - 1);
+
+    for (int32 by = top >> SOLIDITY_BLOCK_SHIFT; by <= bottom >> SOLIDITY_BLOCK_SHIFT; ++by) {
+        int32 rowStart = by == (top >> SOLIDITY_BLOCK_SHIFT) ? (top & SOLIDITY_BLOCK_MASK) : 0;
+        int32 rowEnd   = by == (bottom >> SOLIDITY_BLOCK_SHIFT) ? (bottom & SOLIDITY_BLOCK_MASK) : SOLIDITY_BLOCK_MASK;
+        uint64 rows    = (~0ULL >> ((7 - rowEnd) << 3)) & (~0ULL << (rowStart << 3));
+
+        for (int32 bx = left >> SOLIDITY_BLOCK_SHIFT; bx <= right >> SOLIDITY_BLOCK_SHIFT; ++bx) {
+            int32 columnStart = bx == (left >> SOLIDITY_BLOCK_SHIFT) ? (left & SOLIDITY_BLOCK_MASK) : 0;
+            int32 columnEnd   = bx == (right >> SOLIDITY_BLOCK_SHIFT) ? (right & SOLIDITY_BLOCK_MASK) : SOLIDITY_BLOCK_MASK;
+            uint64 columns    = (uint64)((0xFF >> (7 - columnEnd)) & (0xFF << columnStart)) * 0x0101010101010101ULL;
+
+            if (GetSolidityBits(solidity, solid, bx, by) & rows & columns)
+                return true;
+        }
+    }
+
+    return false;
 }
+#else
+static inline bool32 CheckSolidColumn(uint16 layerID, int32 solid, int32 tileX, int32 tileY) { return true; }
+static inline bool32 CheckSolidRow(uint16 layerID, int32 solid, int32 tileX, int32 tileY) { return true; }
+static inline bool32 CheckSolidRect(uint16 layerID, int32 solid, int32 left, int32 top, int32 right, int32 bottom) { return true; }
 #endif
 
+// reads tiles straight out of a v5 layer, x & y are relative to it & whatever's sweeping has already checked the sensor's position
+// across its axis (x for floor/roof, y for walls) is inside the layer
+struct LayerTileSource {
+    TileLayer *layer;
+    int32 solid;
+    uint8 cPlane;
+
+    template <uint8 cMode> inline bool32 GetSurface(int32 x, int32 y, TileSurface *surface)
+    {
+        int32 along = IsVerticalSensor<cMode>() ? y : x;
+        if (along < 0 || along >= TILE_SIZE * (IsVerticalSensor<cMode>() ? layer->ysize : layer->xsize))
+            return false;
+
+        uint16 tile = layer->layout[GetLayoutIndex(layer, x / TILE_SIZE, y / TILE_SIZE)];
+        if (tile >= 0xFFFF || !(tile & solid))
+            return false;
+
+        int32 mask = GetTileHeight(cPlane, cMode, tile, (IsVerticalSensor<cMode>() ? x : y) & 0xF);
+        if (mask >= 0xFF)
+            return false;
+
+        surface->pos   = (along & -TILE_SIZE) + mask;
+        surface->angle = GetTileAngle(tile, cPlane, cMode);
+        return true;
+    }
+};
+
+// sweeps every layer in cLayers for a sensor at (posX, posY), onSurface(surface, layer, colX, colY) is given the sensor's position
+// relative to the layer being checked & anything it moves that to carries over to the next layer
+template <uint8 cMode, typename SurfaceFunc>
+static inline void SweepTileLayers(uint16 cLayers, uint8 cPlane, int32 solid, int32 stepCount, int32 &posX, int32 &posY, SurfaceFunc onSurface)
+{
+    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
+        if (cLayers & layerID) {
+            TileLayer *layer = &tileLayers[l];
+            int32 colX       = posX - layer->position.x;
+            int32 colY       = posY - layer->position.y;
+
+            bool32 inLayer = false;
+            if (IsVerticalSensor<cMode>())
+                inLayer = colX >= 0 && colX < TILE_SIZE * layer->xsize && CheckSolidColumn(l, solid, colX >> 4, (colY >> 4) - 1);
+            else
+                inLayer = colY >= 0 && colY < TILE_SIZE * layer->ysize && CheckSolidRow(l, solid, (colX >> 4) - 1, colY >> 4);
+
+            if (inLayer) {
+                LayerTileSource source = { layer, solid, cPlane };
+                SweepTileSurfaces<cMode>(source, colX, colY, stepCount, [&](TileSurface &surface) { return onSurface(surface, layer, colX, colY); });
+            }
+
+            posX = layer->position.x + colX;
+            posY = layer->position.y + colY;
+        }
+    }
+}
+
 bool32 RSDK::CheckObjectCollisionTouch(Entity *thisEntity, Hitbox *thisHitbox, Entity *otherEntity, Hitbox *otherHitbox)
 {
     int32 store = 0;
@@ -612,149 +771,77 @@ bool32 RSDK::CheckObjectCollisionPlatform(Entity *thisEntity, Hitbox *thisHitbox
     return collided;
 }
 
+// moves (posX, posY) onto the first surface it's no more than 14 pixels inside of
+template <uint8 cMode> static inline bool32 ObjectTileCollisionKernel(uint16 cLayers, uint8 cPlane, int32 &posX, int32 &posY)
+{
+    bool32 collided = false;
+    int32 solid     = cMode == CMODE_FLOOR ? (cPlane ? (1 << 14) : (1 << 12)) : (cPlane ? (1 << 15) : (1 << 13));
+
+    SweepTileLayers<cMode>(cLayers, cPlane, solid, 3, posX, posY, [&](TileSurface &surface, TileLayer *, int32 &colX, int32 &colY) {
+        int32 &col    = IsVerticalSensor<cMode>() ? colY : colX;
+        bool32 inside = GetSensorSweepStep<cMode>() > 0 ? col >= surface.pos : col <= surface.pos;
+
+        if (inside && abs(col - surface.pos) <= 14) {
+            collided = true;
+            col      = surface.pos;
+            return true;
+        }
+
+        return false;
+    });
+
+    return collided;
+}
+
+// moves (posX, posY) onto the first surface it finds, as long as that's within "tolerance" pixels
+template <uint8 cMode> static inline bool32 ObjectTileGripKernel(uint16 cLayers, uint8 cPlane, int32 tolerance, int32 &posX, int32 &posY)
+{
+    bool32 collided = false;
+    int32 solid     = cMode == CMODE_FLOOR ? (cPlane ? (1 << 14) : (1 << 12)) : (cPlane ? (1 << 15) : (1 << 13));
+
+    SweepTileLayers<cMode>(cLayers, cPlane, solid, 3, posX, posY, [&](TileSurface &surface, TileLayer *, int32 &colX, int32 &colY) {
+        int32 &col = IsVerticalSensor<cMode>() ? colY : colX;
+
+        if (abs(col - surface.pos) <= tolerance) {
+            collided = true;
+            col      = surface.pos;
+        }
+
+        return true;
+    });
+
+    return collided;
+}
+
 bool32 RSDK::ObjectTileCollision(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cPlane, int32 xOffset, int32 yOffset, bool32 setPos)
 {
-    int32 layerID   = 1;
     bool32 collided = false;
     int32 posX      = FROM_FIXED(xOffset + entity->position.x);
     int32 posY      = FROM_FIXED(yOffset + entity->position.y);
 
-    int32 solid = 0;
     switch (cMode) {
         default: return false;
 
         case CMODE_FLOOR:
-            solid = cPlane ? (1 << 14) : (1 << 12);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cy         = (colY & -TILE_SIZE) - TILE_SIZE;
-                    if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                                uint16 tile = layer->layout[(colX / TILE_SIZE) + ((cy / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 ty = cy + collisionMasks[cPlane][tile & 0xFFF].floorMasks[colX & 0xF];
-                                    if (colY >= ty && abs(colY - ty) <= 14) {
-                                        collided = true;
-                                        colY     = ty;
-                                        i        = 3;
-                                    }
-                                }
-                            }
-                            cy += TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileCollisionKernel<CMODE_FLOOR>(cLayers, cPlane, posX, posY);
             if (setPos && collided)
                 entity->position.y = TO_FIXED(posY) - yOffset;
             return collided;
 
         case CMODE_LWALL:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cx         = (colX & -TILE_SIZE) - TILE_SIZE;
-                    if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                                uint16 tile = layer->layout[(cx >> 4) + ((colY / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 tx = cx + collisionMasks[cPlane][tile & 0xFFF].lWallMasks[colY & 0xF];
-                                    if (colX >= tx && abs(colX - tx) <= 14) {
-                                        collided = true;
-                                        colX     = tx;
-                                        i        = 3;
-                                    }
-                                }
-                            }
-                            cx += TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileCollisionKernel<CMODE_LWALL>(cLayers, cPlane, posX, posY);
             if (setPos && collided)
                 entity->position.x = TO_FIXED(posX) - xOffset;
             return collided;
 
         case CMODE_ROOF:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cy         = (colY & -TILE_SIZE) + TILE_SIZE;
-                    if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                                uint16 tile = layer->layout[(colX >> 4) + ((cy / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 ty = cy + collisionMasks[cPlane][tile & 0xFFF].roofMasks[colX & 0xF];
-                                    if (colY <= ty && abs(colY - ty) <= 14) {
-                                        collided = true;
-                                        colY     = ty;
-                                        i        = 3;
-                                    }
-                                }
-                            }
-                            cy -= TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileCollisionKernel<CMODE_ROOF>(cLayers, cPlane, posX, posY);
             if (setPos && collided)
                 entity->position.y = TO_FIXED(posY) - yOffset;
             return collided;
 
         case CMODE_RWALL:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cx         = (colX & -TILE_SIZE) + TILE_SIZE;
-                    if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                                uint16 tile = layer->layout[(cx >> 4) + ((colY / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 tx = cx + collisionMasks[cPlane][tile & 0xFFF].rWallMasks[colY & 0xF];
-                                    if (colX <= tx && abs(colX - tx) <= 14) {
-                                        collided = true;
-                                        colX     = tx;
-                                        i        = 3;
-                                    }
-                                }
-                            }
-                            cx -= TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileCollisionKernel<CMODE_RWALL>(cLayers, cPlane, posX, posY);
             if (setPos && collided)
                 entity->position.x = TO_FIXED(posX) - xOffset;
             return collided;
@@ -762,159 +849,33 @@ bool32 RSDK::ObjectTileCollision(Entity *entity, uint16 cLayers, uint8 cMode, ui
 }
 bool32 RSDK::ObjectTileGrip(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cPlane, int32 xOffset, int32 yOffset, int32 tolerance)
 {
-    int32 layerID   = 1;
     bool32 collided = false;
     int32 posX      = FROM_FIXED(xOffset + entity->position.x);
     int32 posY      = FROM_FIXED(yOffset + entity->position.y);
 
-    int32 solid = 0;
     switch (cMode) {
         default: return false;
 
         case CMODE_FLOOR:
-            solid = cPlane ? (1 << 14) : (1 << 12);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cy         = (colY & -TILE_SIZE) - TILE_SIZE;
-                    if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                                uint16 tile = layer->layout[(colX >> 4) + ((cy / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 mask = collisionMasks[cPlane][tile & 0xFFF].floorMasks[colX & 0xF];
-                                    int32 ty   = cy + mask;
-                                    if (mask < 0xFF) {
-                                        if (abs(colY - ty) <= tolerance) {
-                                            collided = true;
-                                            colY     = ty;
-                                        }
-                                        i = 3;
-                                    }
-                                }
-                            }
-                            cy += TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileGripKernel<CMODE_FLOOR>(cLayers, cPlane, tolerance, posX, posY);
             if (collided)
                 entity->position.y = TO_FIXED(posY) - yOffset;
             return collided;
 
         case CMODE_LWALL:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cx         = (colX & -TILE_SIZE) - TILE_SIZE;
-                    if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                                uint16 tile = layer->layout[(cx >> 4) + ((colY / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 mask = collisionMasks[cPlane][tile & 0xFFF].lWallMasks[colY & 0xF];
-                                    int32 tx   = cx + mask;
-                                    if (mask < 0xFF) {
-                                        if (abs(colX - tx) <= tolerance) {
-                                            collided = true;
-                                            colX     = tx;
-                                        }
-                                        i = 3;
-                                    }
-                                }
-                            }
-                            cx += TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileGripKernel<CMODE_LWALL>(cLayers, cPlane, tolerance, posX, posY);
             if (collided)
                 entity->position.x = TO_FIXED(posX) - xOffset;
             return collided;
 
         case CMODE_ROOF:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cy         = (colY & -TILE_SIZE) + TILE_SIZE;
-                    if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                                uint16 tile = layer->layout[(colX >> 4) + ((cy / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 mask = collisionMasks[cPlane][tile & 0xFFF].roofMasks[colX & 0xF];
-                                    int32 ty   = cy + mask;
-                                    if (mask < 0xFF) {
-                                        if (abs(colY - ty) <= tolerance) {
-                                            collided = true;
-                                            colY     = ty;
-                                        }
-                                        i = 3;
-                                    }
-                                }
-                            }
-                            cy -= TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileGripKernel<CMODE_ROOF>(cLayers, cPlane, tolerance, posX, posY);
             if (collided)
                 entity->position.y = TO_FIXED(posY) - yOffset;
             return collided;
 
         case CMODE_RWALL:
-            solid = cPlane ? (1 << 15) : (1 << 13);
-
-            for (int32 l = 0; l < LAYER_COUNT; ++l, layerID <<= 1) {
-                if (cLayers & layerID) {
-                    TileLayer *layer = &tileLayers[l];
-                    int32 colX       = posX - layer->position.x;
-                    int32 colY       = posY - layer->position.y;
-                    int32 cx         = (colX & -TILE_SIZE) + TILE_SIZE;
-                    if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                        for (int32 i = 0; i < 3; ++i) {
-                            if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                                uint16 tile = layer->layout[(cx >> 4) + ((colY / TILE_SIZE) << layer->widthShift)];
-                                if (tile < 0xFFFF && tile & solid) {
-                                    int32 mask = collisionMasks[cPlane][tile & 0xFFF].rWallMasks[colY & 0xF];
-                                    int32 tx   = cx + mask;
-                                    if (mask < 0xFF) {
-                                        if (abs(colX - tx) <= tolerance) {
-                                            collided = true;
-                                            colX     = tx;
-                                        }
-                                        i = 3;
-                                    }
-                                }
-                            }
-                            cx -= TILE_SIZE;
-                        }
-                    }
-                    posX = layer->position.x + colX;
-                    posY = layer->position.y + colY;
-                }
-            }
-
+            collided = ObjectTileGripKernel<CMODE_RWALL>(cLayers, cPlane, tolerance, posX, posY);
             if (collided)
                 entity->position.x = TO_FIXED(posX) - xOffset;
             return collided;
@@ -1002,6 +963,137 @@ void RSDK::ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *inner
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// how far past the hitbox (in pixels) any sensor ProcessObjectMovement sets up could end up reading tiles from:
+// a tile either side of the one the sensor's in, plus the collision offset (which the wall sensors can double)
+#define MOVEMENT_SENSOR_REACH (TILE_SIZE * 2 + 16)
+
+// the pixel rect each of the (up to) 4 entities could touch this frame, as left/top/right/bottom of its whole move padded by the box
+static inline void GetMovementBounds(Entity **entities, int32 count, Hitbox *box, int32 (*bounds)[4])
+{
+    alignas(16) int32 posX[4] = { 0, 0, 0, 0 };
+    alignas(16) int32 posY[4] = { 0, 0, 0, 0 };
+    alignas(16) int32 velX[4] = { 0, 0, 0, 0 };
+    alignas(16) int32 velY[4] = { 0, 0, 0, 0 };
+    for (int32 e = 0; e < count; ++e) {
+        if (entities[e]) {
+            posX[e] = entities[e]->position.x;
+            posY[e] = entities[e]->position.y;
+            velX[e] = entities[e]->velocity.x;
+            velY[e] = entities[e]->velocity.y;
+        }
+    }
+
+    alignas(16) int32 left[4], top[4], right[4], bottom[4];
+#if RETRO_SIMD_SSE2
+    __m128i startX = _mm_load_si128((const __m128i *)posX);
+    __m128i startY = _mm_load_si128((const __m128i *)posY);
+    __m128i endX   = _mm_srai_epi32(_mm_add_epi32(startX, _mm_load_si128((const __m128i *)velX)), 16);
+    __m128i endY   = _mm_srai_epi32(_mm_add_epi32(startY, _mm_load_si128((const __m128i *)velY)), 16);
+    startX         = _mm_srai_epi32(startX, 16);
+    startY         = _mm_srai_epi32(startY, 16);
+
+    // no min/max for 32-bit ints until SSE4.1
+    __m128i moveLeft = _mm_cmpgt_epi32(startX, endX);
+    __m128i moveUp   = _mm_cmpgt_epi32(startY, endY);
+    __m128i minX     = _mm_or_si128(_mm_and_si128(moveLeft, endX), _mm_andnot_si128(moveLeft, startX));
+    __m128i maxX     = _mm_or_si128(_mm_and_si128(moveLeft, startX), _mm_andnot_si128(moveLeft, endX));
+    __m128i minY     = _mm_or_si128(_mm_and_si128(moveUp, endY), _mm_andnot_si128(moveUp, startY));
+    __m128i maxY     = _mm_or_si128(_mm_and_si128(moveUp, startY), _mm_andnot_si128(moveUp, endY));
+
+    _mm_store_si128((__m128i *)left, _mm_add_epi32(minX, _mm_set1_epi32(box->left)));
+    _mm_store_si128((__m128i *)top, _mm_add_epi32(minY, _mm_set1_epi32(box->top)));
+    _mm_store_si128((__m128i *)right, _mm_add_epi32(maxX, _mm_set1_epi32(box->right)));
+    _mm_store_si128((__m128i *)bottom, _mm_add_epi32(maxY, _mm_set1_epi32(box->bottom)));
+#elif RETRO_SIMD_NEON
+    int32x4_t startX = vld1q_s32(posX);
+    int32x4_t startY = vld1q_s32(posY);
+    int32x4_t endX   = vshrq_n_s32(vaddq_s32(startX, vld1q_s32(velX)), 16);
+    int32x4_t endY   = vshrq_n_s32(vaddq_s32(startY, vld1q_s32(velY)), 16);
+    startX           = vshrq_n_s32(startX, 16);
+    startY           = vshrq_n_s32(startY, 16);
+
+    vst1q_s32(left, vaddq_s32(vminq_s32(startX, endX), vdupq_n_s32(box->left)));
+    vst1q_s32(top, vaddq_s32(vminq_s32(startY, endY), vdupq_n_s32(box->top)));
+    vst1q_s32(right, vaddq_s32(vmaxq_s32(startX, endX), vdupq_n_s32(box->right)));
+    vst1q_s32(bottom, vaddq_s32(vmaxq_s32(startY, endY), vdupq_n_s32(box->bottom)));
+#else
+    for (int32 e = 0; e < 4; ++e) {
+        int32 startX = FROM_FIXED(posX[e]);
+        int32 startY = FROM_FIXED(posY[e]);
+        int32 endX   = FROM_FIXED(posX[e] + velX[e]);
+        int32 endY   = FROM_FIXED(posY[e] + velY[e]);
+
+        left[e]   = MIN(startX, endX) + box->left;
+        top[e]    = MIN(startY, endY) + box->top;
+        right[e]  = MAX(startX, endX) + box->right;
+        bottom[e] = MAX(startY, endY) + box->bottom;
+    }
+#endif
+
+    for (int32 e = 0; e < count; ++e) {
+        bounds[e][0] = left[e];
+        bounds[e][1] = top[e];
+        bounds[e][2] = right[e];
+        bounds[e][3] = bottom[e];
+    }
+}
+
+// returns false if there's no tile the entity collides with anywhere in "bounds" (in pixels) on any of its collision layers
+static bool32 CheckMovementSolidity(Entity *entity, int32 *bounds)
+{
+    int32 solid = entity->collisionPlane ? ((1 << 14) | (1 << 15)) : ((1 << 12) | (1 << 13));
+
+    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
+        if (entity->collisionLayers & layerID) {
+            TileLayer *layer = &tileLayers[l];
+            if (CheckSolidRect(l, solid, (bounds[0] - layer->position.x) >> 4, (bounds[1] - layer->position.y) >> 4,
+                               (bounds[2] - layer->position.x) >> 4, (bounds[3] - layer->position.y) >> 4))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void RSDK::ProcessObjectMovementBatch(Entity **entities, int32 count, Hitbox *outerBox, Hitbox *innerBox)
+{
+    if (!entities || !outerBox || !innerBox)
+        return;
+
+    // one box that covers both hitboxes (whichever way round they are) & everywhere a sensor could reach from them
+    Hitbox reach;
+    reach.left   = MIN(MIN(outerBox->left, outerBox->right), MIN(innerBox->left, innerBox->right)) - MOVEMENT_SENSOR_REACH;
+    reach.top    = MIN(MIN(outerBox->top, outerBox->bottom), MIN(innerBox->top, innerBox->bottom)) - MOVEMENT_SENSOR_REACH;
+    reach.right  = MAX(MAX(outerBox->left, outerBox->right), MAX(innerBox->left, innerBox->right)) + MOVEMENT_SENSOR_REACH;
+    reach.bottom = MAX(MAX(outerBox->top, outerBox->bottom), MAX(innerBox->top, innerBox->bottom)) + MOVEMENT_SENSOR_REACH;
+
+    for (int32 e = 0; e < count; e += 4) {
+        int32 laneCount = MIN(count - e, 4);
+
+        int32 bounds[4][4];
+        GetMovementBounds(&entities[e], laneCount, &reach, bounds);
+
+        for (int32 l = 0; l < laneCount; ++l) {
+            Entity *entity = entities[e + l];
+            if (!entity)
+                continue;
+
+            if (entity->tileCollisions && !entity->onGround && !CheckMovementSolidity(entity, bounds[l])) {
+                // nothing to hit anywhere it could get to, so the air collision would just end up moving it by its velocity
+                entity->angle &= 0xFF;
+                entity->position.x += entity->velocity.x;
+                entity->position.y += entity->velocity.y;
+                entity->groundVel = entity->velocity.x;
+            }
+            else {
+                ProcessObjectMovement(entity, outerBox, innerBox);
+            }
+        }
+    }
+}
+#endif
+
 void RSDK::ProcessAirCollision_Down()
 {
     uint8 movingDown  = 0;
@@ -2159,11 +2251,35 @@ void RSDK::SetPathGripSensors(CollisionSensor *sensors)
     }
 }
 
-void RSDK::FindFloorPosition(CollisionSensor *sensor)
+// everything Find*Position does besides which tiles count as solid & how close the angle has to be is the same for every cMode
+template <uint8 cMode, typename AngleFunc> static inline void FindSensorPosition(CollisionSensor *sensor, int32 solid, AngleFunc checkAngle)
 {
-    int32 posX = FROM_FIXED(sensor->position.x);
-    int32 posY = FROM_FIXED(sensor->position.y);
+    int32 posX  = FROM_FIXED(sensor->position.x);
+    int32 posY  = FROM_FIXED(sensor->position.y);
+    int32 start = IsVerticalSensor<cMode>() ? posY : posX;
+
+    SweepTileLayers<cMode>(collisionEntity->collisionLayers, collisionEntity->collisionPlane, solid, 3, posX, posY,
+                           [&](TileSurface &surface, TileLayer *layer, int32 &colX, int32 &colY) {
+                               int32 col     = IsVerticalSensor<cMode>() ? colY : colX;
+                               bool32 closer = GetSensorSweepStep<cMode>() > 0 ? start >= surface.pos : start <= surface.pos;
+
+                               if ((!sensor->collided || closer) && abs(col - surface.pos) <= collisionTolerance && checkAngle(surface.angle)) {
+                                   sensor->collided = true;
+                                   sensor->angle    = surface.angle;
+                                   if (IsVerticalSensor<cMode>())
+                                       sensor->position.y = TO_FIXED(surface.pos + layer->position.y);
+                                   else
+                                       sensor->position.x = TO_FIXED(surface.pos + layer->position.x);
+                                   start = surface.pos;
+                                   return true;
+                               }
+
+                               return false;
+                           });
+}
 
+void RSDK::FindFloorPosition(CollisionSensor *sensor)
+{
     int32 solid = 0;
 #if RETRO_REV0U
     if (collisionEntity->tileCollisions == TILECOLLISION_DOWN)
@@ -2174,113 +2290,28 @@ void RSDK::FindFloorPosition(CollisionSensor *sensor)
     solid = collisionEntity->collisionPlane ? (1 << 14) : (1 << 12);
 #endif
 
-    int32 startY = posY;
-
-    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
-            TileLayer *layer = &tileLayers[l];
-            int32 colX       = posX - layer->position.x;
-            int32 colY       = posY - layer->position.y;
-            int32 cy         = (colY & -TILE_SIZE) - TILE_SIZE;
-            if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                for (int32 i = 0; i < 3; ++i) {
-                    if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                        uint16 tile = layer->layout[(colX / TILE_SIZE) + ((cy / TILE_SIZE) << layer->widthShift)];
-
-                        if (tile < 0xFFFF && tile & solid) {
-                            int32 mask      = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].floorMasks[colX & 0xF];
-                            int32 ty        = cy + mask;
-                            int32 tileAngle = tileInfo[collisionEntity->collisionPlane][tile & 0xFFF].floorAngle;
-
-                            if (mask < 0xFF) {
-                                if (!sensor->collided || startY >= ty) {
-                                    if (abs(colY - ty) <= collisionTolerance) {
+    FindSensorPosition<CMODE_FLOOR>(sensor, solid, [sensor](int32 tileAngle) {
 #if RETRO_REV0U
 #if !RETRO_USE_ORIGINAL_CODE
-                                        if (abs(sensor->angle - tileAngle) <= TILE_SIZE * 2 // * 3 causes some issues in certain tiles
+        return abs(sensor->angle - tileAngle) <= TILE_SIZE * 2 // * 3 causes some issues in certain tiles
 #else
-                                        if (abs(sensor->angle - tileAngle) <= TILE_SIZE * 3
+        return abs(sensor->angle - tileAngle) <= TILE_SIZE * 3
 #endif
-                                            || abs(sensor->angle - tileAngle + 0x100) <= floorAngleTolerance
-                                            || abs(sensor->angle - tileAngle - 0x100) <= floorAngleTolerance) {
+               || abs(sensor->angle - tileAngle + 0x100) <= floorAngleTolerance || abs(sensor->angle - tileAngle - 0x100) <= floorAngleTolerance;
 #else
-                                        if (abs(sensor->angle - tileAngle) <= 0x20 || abs(sensor->angle - tileAngle + 0x100) <= 0x20
-                                            || abs(sensor->angle - tileAngle - 0x100) <= 0x20) {
+        return abs(sensor->angle - tileAngle) <= 0x20 || abs(sensor->angle - tileAngle + 0x100) <= 0x20
+               || abs(sensor->angle - tileAngle - 0x100) <= 0x20;
 #endif
-                                            sensor->collided   = true;
-                                            sensor->angle      = tileAngle;
-                                            sensor->position.y = TO_FIXED(ty + layer->position.y);
-                                            startY             = ty;
-                                            i                  = 3;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    cy += TILE_SIZE;
-                }
-            }
-
-            posX = layer->position.x + colX;
-            posY = layer->position.y + colY;
-        }
-    }
+    });
 }
 void RSDK::FindLWallPosition(CollisionSensor *sensor)
 {
-    int32 posX = FROM_FIXED(sensor->position.x);
-    int32 posY = FROM_FIXED(sensor->position.y);
-
     int32 solid = collisionEntity->collisionPlane ? ((1 << 14) | (1 << 15)) : ((1 << 12) | (1 << 13));
 
-    int32 startX = posX;
-
-    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
-            TileLayer *layer = &tileLayers[l];
-            int32 colX       = posX - layer->position.x;
-            int32 colY       = posY - layer->position.y;
-            int32 cx         = (colX & -TILE_SIZE) - TILE_SIZE;
-            if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                for (int32 i = 0; i < 3; ++i) {
-                    if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                        uint16 tile = layer->layout[(cx / TILE_SIZE) + ((colY / TILE_SIZE) << layer->widthShift)];
-
-                        if (tile < 0xFFFF && tile & solid) {
-                            int32 mask      = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].lWallMasks[colY & 0xF];
-                            int32 tx        = cx + mask;
-                            int32 tileAngle = tileInfo[collisionEntity->collisionPlane][tile & 0xFFF].lWallAngle;
-
-                            if (mask < 0xFF) {
-                                if (!sensor->collided || startX >= tx) {
-                                    if (abs(colX - tx) <= collisionTolerance && abs(sensor->angle - tileAngle) <= wallAngleTolerance) {
-                                        sensor->collided   = true;
-                                        sensor->angle      = tileAngle;
-                                        sensor->position.x = TO_FIXED(tx + layer->position.x);
-                                        startX             = tx;
-                                        i                  = 3;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    cx += TILE_SIZE;
-                }
-            }
-
-            posX = layer->position.x + colX;
-            posY = layer->position.y + colY;
-        }
-    }
+    FindSensorPosition<CMODE_LWALL>(sensor, solid, [sensor](int32 tileAngle) { return abs(sensor->angle - tileAngle) <= wallAngleTolerance; });
 }
 void RSDK::FindRoofPosition(CollisionSensor *sensor)
 {
-    int32 posX = FROM_FIXED(sensor->position.x);
-    int32 posY = FROM_FIXED(sensor->position.y);
-
     int32 solid = 0;
 #if RETRO_REV0U
     if (collisionEntity->tileCollisions == TILECOLLISION_DOWN)
@@ -2291,96 +2322,13 @@ void RSDK::FindRoofPosition(CollisionSensor *sensor)
     solid = collisionEntity->collisionPlane ? (1 << 15) : (1 << 13);
 #endif
 
-    int32 startY = posY;
-
-    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
-            TileLayer *layer = &tileLayers[l];
-            int32 colX       = posX - layer->position.x;
-            int32 colY       = posY - layer->position.y;
-            int32 cy         = (colY & -TILE_SIZE) + TILE_SIZE;
-
-            if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
-                for (int32 i = 0; i < 3; ++i) {
-                    if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                        uint16 tile = layer->layout[(colX / TILE_SIZE) + ((cy / TILE_SIZE) << layer->widthShift)];
-
-                        if (tile < 0xFFFF && tile & solid) {
-                            int32 mask      = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].roofMasks[colX & 0xF];
-                            int32 ty        = cy + mask;
-                            int32 tileAngle = tileInfo[collisionEntity->collisionPlane][tile & 0xFFF].roofAngle;
-
-                            if (mask < 0xFF) {
-                                if (!sensor->collided || startY <= ty) {
-                                    if (abs(colY - ty) <= collisionTolerance && abs(sensor->angle - tileAngle) <= roofAngleTolerance) {
-                                        sensor->collided   = true;
-                                        sensor->angle      = tileAngle;
-                                        sensor->position.y = TO_FIXED(ty + layer->position.y);
-                                        startY             = ty;
-                                        i                  = 3;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    cy -= TILE_SIZE;
-                }
-            }
-
-            posX = layer->position.x + colX;
-            posY = layer->position.y + colY;
-        }
-    }
+    FindSensorPosition<CMODE_ROOF>(sensor, solid, [sensor](int32 tileAngle) { return abs(sensor->angle - tileAngle) <= roofAngleTolerance; });
 }
 void RSDK::FindRWallPosition(CollisionSensor *sensor)
 {
-    int32 posX = FROM_FIXED(sensor->position.x);
-    int32 posY = FROM_FIXED(sensor->position.y);
-
     int32 solid = collisionEntity->collisionPlane ? ((1 << 14) | (1 << 15)) : ((1 << 12) | (1 << 13));
 
-    int32 startX = posX;
-
-    for (int32 l = 0, layerID = 1; l < LAYER_COUNT; ++l, layerID <<= 1) {
-        if (collisionEntity->collisionLayers & layerID) {
-            TileLayer *layer = &tileLayers[l];
-            int32 colX       = posX - layer->position.x;
-            int32 colY       = posY - layer->position.y;
-            int32 cx         = (colX & -TILE_SIZE) + TILE_SIZE;
-
-            if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
-                for (int32 i = 0; i < 3; ++i) {
-                    if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                        uint16 tile = layer->layout[(cx / TILE_SIZE) + ((colY / TILE_SIZE) << layer->widthShift)];
-
-                        if (tile < 0xFFFF && tile & solid) {
-                            int32 mask      = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].rWallMasks[colY & 0xF];
-                            int32 tx        = cx + mask;
-                            int32 tileAngle = tileInfo[collisionEntity->collisionPlane][tile & 0xFFF].rWallAngle;
-
-                            if (mask < 0xFF) {
-                                if (!sensor->collided || startX <= tx) {
-                                    if (abs(colX - tx) <= collisionTolerance && abs(sensor->angle - tileAngle) <= wallAngleTolerance) {
-                                        sensor->collided   = true;
-                                        sensor->angle      = tileAngle;
-                                        sensor->position.x = TO_FIXED(tx + layer->position.x);
-                                        startX             = tx;
-                                        i                  = 3;
-                                    }
-                                }
-                            }
-                        }
-                    }
-
-                    cx -= TILE_SIZE;
-                }
-            }
-
-            posX = layer->position.x + colX;
-            posY = layer->position.y + colY;
-        }
-    }
+    FindSensorPosition<CMODE_RWALL>(sensor, solid, [sensor](int32 tileAngle) { return abs(sensor->angle - tileAngle) <= wallAngleTolerance; });
 }
 
 void RSDK::FloorCollision(CollisionSensor *sensor)
@@ -2410,7 +2358,7 @@ void RSDK::FloorCollision(CollisionSensor *sensor)
             int32 colY       = posY - layer->position.y;
             int32 cy         = (colY & -TILE_SIZE) - TILE_SIZE;
 
-            if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
+            if (colX >= 0 && colX < TILE_SIZE * layer->xsize && CheckSolidColumn(l, solid, colX >> 4, cy >> 4)) {
 #if RETRO_REV0U
                 int32 stepCount = 2;
 #else
@@ -2420,9 +2368,9 @@ void RSDK::FloorCollision(CollisionSensor *sensor)
                     int32 step = TILE_SIZE;
 
                     if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
-                        uint16 tile = layer->layout[(colX / TILE_SIZE) + ((cy / TILE_SIZE) << layer->widthShift)];
+                        uint16 tile = layer->layout[GetLayoutIndex(layer, colX / TILE_SIZE, cy / TILE_SIZE)];
                         if (tile < 0xFFFF && tile & solid) {
-                            int32 mask = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].floorMasks[colX & 0xF];
+                            int32 mask = GetTileHeight(collisionEntity->collisionPlane, CMODE_FLOOR, tile, colX & 0xF);
 #if RETRO_REV0U
                             int32 ty = layer->position.y + cy + mask;
 #else
@@ -2483,13 +2431,13 @@ void RSDK::LWallCollision(CollisionSensor *sensor)
             int32 colY       = posY - layer->position.y;
             int32 cx         = (colX & -TILE_SIZE) - TILE_SIZE;
 
-            if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
+            if (colY >= 0 && colY < TILE_SIZE * layer->ysize && CheckSolidRow(l, solid, cx >> 4, colY >> 4)) {
                 for (int32 i = 0; i < 3; ++i) {
                     if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                        uint16 tile = layer->layout[(cx / TILE_SIZE) + ((colY / TILE_SIZE) << layer->widthShift)];
+                        uint16 tile = layer->layout[GetLayoutIndex(layer, cx / TILE_SIZE, colY / TILE_SIZE)];
 
                         if (tile < 0xFFFF && tile & solid) {
-                            int32 mask = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].lWallMasks[colY & 0xF];
+                            int32 mask = GetTileHeight(collisionEntity->collisionPlane, CMODE_LWALL, tile, colY & 0xF);
                             int32 tx   = cx + mask;
                             if (mask < 0xFF && colX >= tx && abs(colX - tx) <= 14) {
                                 sensor->collided   = true;
@@ -2536,7 +2484,7 @@ void RSDK::RoofCollision(CollisionSensor *sensor)
             int32 colY       = posY - layer->position.y;
             int32 cy         = (colY & -TILE_SIZE) + TILE_SIZE;
 
-            if (colX >= 0 && colX < TILE_SIZE * layer->xsize) {
+            if (colX >= 0 && colX < TILE_SIZE * layer->xsize && CheckSolidColumn(l, solid, colX >> 4, (cy >> 4) - 2)) {
 #if RETRO_REV0U
                 int32 stepCount = 2;
 #else
@@ -2548,10 +2496,10 @@ void RSDK::RoofCollision(CollisionSensor *sensor)
                     if (cy >= 0 && cy < TILE_SIZE * layer->ysize) {
                         int32 tileX = (colX / TILE_SIZE);
                         int32 tileY = (cy / TILE_SIZE);
-                        uint16 tile = layer->layout[tileX + (tileY << layer->widthShift)];
+                        uint16 tile = layer->layout[GetLayoutIndex(layer, tileX, tileY)];
 
                         if (tile < 0xFFFF && tile & solid) {
-                            int32 mask = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].roofMasks[colX & 0xF];
+                            int32 mask = GetTileHeight(collisionEntity->collisionPlane, CMODE_ROOF, tile, colX & 0xF);
 #if RETRO_REV0U
                             int32 ty = layer->position.y + cy + mask;
 #else
@@ -2609,13 +2557,13 @@ void RSDK::RWallCollision(CollisionSensor *sensor)
             int32 colY       = posY - layer->position.y;
             int32 cx         = (colX & -TILE_SIZE) + TILE_SIZE;
 
-            if (colY >= 0 && colY < TILE_SIZE * layer->ysize) {
+            if (colY >= 0 && colY < TILE_SIZE * layer->ysize && CheckSolidRow(l, solid, (cx >> 4) - 2, colY >> 4)) {
                 for (int32 i = 0; i < 3; ++i) {
                     if (cx >= 0 && cx < TILE_SIZE * layer->xsize) {
-                        uint16 tile = layer->layout[(cx / TILE_SIZE) + ((colY / TILE_SIZE) << layer->widthShift)];
+                        uint16 tile = layer->layout[GetLayoutIndex(layer, cx / TILE_SIZE, colY / TILE_SIZE)];
 
                         if (tile < 0xFFFF && tile & solid) {
-                            int32 mask = collisionMasks[collisionEntity->collisionPlane][tile & 0xFFF].rWallMasks[colY & 0xF];
+                            int32 mask = GetTileHeight(collisionEntity->collisionPlane, CMODE_RWALL, tile, colY & 0xF);
                             int32 tx   = cx + mask;
                             if (mask < 0xFF && colX <= tx && abs(colX - tx) <= 14) {
                                 sensor->collided   = true;
@@ -88,8 +88,13 @@ void CopyCollisionMask(uint16 dst, uint16 src, uint8 cPlane, uint8 cMode);
 
 inline void GetCollisionInfo(CollisionMask **masks, TileInfo **tileInfo)
 {
-    if (masks)
+    if (masks) {
         *masks = (RSDK::CollisionMask *)collisionMasks;
+#if RETRO_USE_SOLIDITY_BITMAPS
+        // no way of knowing when (or what) they'll write, so the packed copy can't be used from here on
+        tileHeightFieldsShared = true;
+#endif
+    }
 
     if (tileInfo)
         *tileInfo = (RSDK::TileInfo *)tileInfo;
@@ -130,6 +135,11 @@ bool32 ObjectTileCollision(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cP
 bool32 ObjectTileGrip(Entity *entity, uint16 cLayers, uint8 cMode, uint8 cPlane, int32 xOffset, int32 yOffset, int32 tolerance);
 
 void ProcessObjectMovement(Entity *entity, Hitbox *outerBox, Hitbox *innerBox);
+#if !RETRO_USE_ORIGINAL_CODE
+// same as calling ProcessObjectMovement on each entity with the same hitboxes, but every entity's whole move is checked against the solidity
+// bitmaps first, so anything in the air with nothing solid in reach skips the sensors entirely (NULL entries are skipped)
+void ProcessObjectMovementBatch(Entity **entities, int32 count, Hitbox *outerBox, Hitbox *innerBox);
+#endif
 
 void ProcessPathGrip();
 void ProcessAirCollision_Down();
@@ -0,0 +1,32 @@
+// Generic tile sensor kernel, this gets included into Collision.cpp & is shared by the v5 & legacy (v3/v4) tile collision code
+// the sweep's the same for all of them, the only real difference is where the tiles come from, so that's left up to a "tile source":
+//     template <uint8 cMode> bool32 GetSurface(int32 x, int32 y, TileSurface *surface)
+// which checks the tile pixel (x, y) is in & returns true (filling in "surface") if it has a cMode surface along column x (row y for walls)
+// everything's templated on cMode so each sensor gets its own copy with the mode checks folded away
+
+// a surface a sensor found, "pos" is where it is along the sensor's axis (y for floor/roof, x for walls) & "angle" is always 0-0xFF
+struct TileSurface {
+    int32 pos;
+    int32 angle;
+};
+
+// floor & roof sensors look along y, walls along x
+template <uint8 cMode> static inline bool32 IsVerticalSensor() { return cMode == CMODE_FLOOR || cMode == CMODE_ROOF; }
+
+// floor & lwall surfaces push things up/left, so their sweeps go down/right (& roof/rwall the other way)
+template <uint8 cMode> static inline int32 GetSensorSweepStep() { return cMode == CMODE_FLOOR || cMode == CMODE_LWALL ? TILE_SIZE : -TILE_SIZE; }
+
+// checks "stepCount" tiles along the sensor's axis, starting with the one a tile behind (x, y) & sweeping through in cMode's direction
+// onSurface(surface) gets called for every surface found until it returns true, which stops the sweep
+template <uint8 cMode, typename TileSource, typename SurfaceFunc>
+static inline void SweepTileSurfaces(TileSource &source, int32 x, int32 y, int32 stepCount, SurfaceFunc onSurface)
+{
+    int32 step = GetSensorSweepStep<cMode>();
+    int32 *pos = IsVerticalSensor<cMode>() ? &y : &x;
+
+    TileSurface surface;
+    for (*pos -= step; stepCount > 0; --stepCount, *pos += step) {
+        if (source.template GetSurface<cMode>(x, y, &surface) && onSurface(surface))
+            break;
+    }
+}
@@ -1,2 +1,86 @@
+// which tile solidity values legacy sensors collide with, as (1 << solidity) bits, with anything scripts set past bit 31 counting as bit 31
+// (v3 & v4 share the same values for these)
+#define LEGACY_SOLIDITY_TOP (~((1u << Legacy::v4::SOLID_LRB) | (1u << Legacy::v4::SOLID_NONE))) // everything but LRB & NONE
+#define LEGACY_SOLIDITY_ANY ((1u << Legacy::v4::SOLID_NONE) - 1)                                 // ALL, TOP & LRB
+#define LEGACY_SOLIDITY_LRB (LEGACY_SOLIDITY_ANY & ~(1u << Legacy::v4::SOLID_TOP))               // ALL & LRB
+
+// reads tiles from the 128x128 chunks in the first legacy layout, unlike v5 there's no pre-flipped masks so the flips are done here
+struct LegacyTileSource {
+    int32 cPath;
+    uint32 solidity;
+    // the smallest x/y that gets checked (some sensors skip row/column 0 entirely) & whether anything past the end of the layout's skipped too
+    int32 minPos;
+    bool32 clampToLayout;
+    // the last chunk tile that got looked at, solid or not
+    int32 chunk;
+
+    template <uint8 cMode> inline bool32 GetSurface(int32 x, int32 y, TileSurface *surface)
+    {
+        if (x < minPos || y < minPos)
+            return false;
+
+        if (clampToLayout && (x >= Legacy::stageLayouts[0].xsize << 7 || y >= Legacy::stageLayouts[0].ysize << 7))
+            return false;
+
+        chunk = (Legacy::stageLayouts[0].tiles[(x >> 7) + ((y >> 7) << 8)] << 6) + ((x & 0x7F) >> 4) + (((y & 0x7F) >> 4) << 3);
+        if (!((solidity >> MIN(Legacy::tiles128x128.collisionFlags[cPath][chunk], 31)) & 1))
+            return false;
+
+        int32 tileIndex               = Legacy::tiles128x128.tileIndex[chunk];
+        uint8 direction               = Legacy::tiles128x128.direction[chunk];
+        Legacy::CollisionMasks *masks = &Legacy::collisionMasks[cPath];
+
+        // flipping a tile along the sensor's axis means the surface comes from the opposite side's masks,
+        // flipping it across just mirrors which column/row gets read
+        bool32 flipAlong  = direction & (IsVerticalSensor<cMode>() ? FLIP_Y : FLIP_X);
+        bool32 flipAcross = direction & (IsVerticalSensor<cMode>() ? FLIP_X : FLIP_Y);
+
+        int32 pos = (IsVerticalSensor<cMode>() ? x : y) & 0xF;
+        int32 c   = (flipAcross ? 0xF - pos : pos) + (tileIndex << 4);
+
+        int32 mask  = 0;
+        int32 angle = 0;
+        bool32 none = false;
+        switch (flipAlong ? (cMode ^ 2) : cMode) {
+            default:
+            case CMODE_FLOOR:
+                mask  = masks->floorMasks[c];
+                angle = masks->angles[tileIndex] & 0xFF;
+                none  = mask >= 0x40;
+                break;
+
+            case CMODE_LWALL:
+                mask  = masks->lWallMasks[c];
+                angle = (masks->angles[tileIndex] >> 8) & 0xFF;
+                none  = mask >= 0x40;
+                break;
+
+            case CMODE_ROOF:
+                mask  = masks->roofMasks[c];
+                angle = (masks->angles[tileIndex] >> 24) & 0xFF;
+                none  = mask <= -0x40;
+                break;
+
+            case CMODE_RWALL:
+                mask  = masks->rWallMasks[c];
+                angle = (masks->angles[tileIndex] >> 16) & 0xFF;
+                none  = mask <= -0x40;
+                break;
+        }
+
+        if (none)
+            return false;
+
+        if (direction & FLIP_Y)
+            angle = 0x180 - angle;
+        if (direction & FLIP_X)
+            angle = 0x100 - angle;
+
+        surface->pos   = ((IsVerticalSensor<cMode>() ? y : x) & -TILE_SIZE) + (flipAlong ? 0xF - mask : mask);
+        surface->angle = angle & 0xFF;
+        return true;
+    }
+};
+
 #include "v3/CollisionLegacyv3.cpp"
 #include "v4/CollisionLegacyv4.cpp"
\ No newline at end of file
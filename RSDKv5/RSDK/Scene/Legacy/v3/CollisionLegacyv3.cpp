@@ -89,362 +89,118 @@ RSDK::Legacy::Hitbox *RSDK::Legacy::v3::GetPlayerHitbox(Player *player)
 
 void RSDK::Legacy::v3::FindFloorPosition(Player *player, CollisionSensor *sensor, int32 startY)
 {
-    int32 c     = 0;
     int32 angle = sensor->angle;
-    int32 tsm1  = (TILE_SIZE - 1);
-    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
-        if (!sensor->collided) {
-            int32 XPos   = sensor->XPos >> 16;
-            int32 chunkX = XPos >> 7;
-            int32 tileX  = (XPos & 0x7F) >> 4;
-            int32 YPos   = (sensor->YPos >> 16) + i - TILE_SIZE;
-            int32 chunkY = YPos >> 7;
-            int32 tileY  = (YPos & 0x7F) >> 4;
-            if (XPos > -1 && YPos > -1) {
-                int32 tile = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-                tile += tileX + (tileY << 3);
-                int32 tileIndex = tiles128x128.tileIndex[tile];
-                if (tiles128x128.collisionFlags[player->collisionPlane][tile] != SOLID_LRB
-                    && tiles128x128.collisionFlags[player->collisionPlane][tile] != SOLID_NONE) {
-                    switch (tiles128x128.direction[tile]) {
-                        case FLIP_NONE: {
-                            c = (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].floorMasks[c] >= 0x40)
-                                break;
-
-                            sensor->YPos     = collisionMasks[player->collisionPlane].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            sensor->angle    = collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF;
-                            break;
-                        }
-                        case FLIP_X: {
-                            c = tsm1 - (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].floorMasks[c] >= 0x40)
-                                break;
-
-                            sensor->YPos     = collisionMasks[player->collisionPlane].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            sensor->angle    = 0x100 - (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF);
-                            break;
-                        }
-                        case FLIP_Y: {
-                            c = (XPos & 15) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].roofMasks[c] <= -0x40)
-                                break;
-
-                            sensor->YPos     = tsm1 - collisionMasks[player->collisionPlane].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            uint8 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF000000) >> 24;
-                            sensor->angle    = (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                        case FLIP_XY: {
-                            c = tsm1 - (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].roofMasks[c] <= -0x40)
-                                break;
-
-                            sensor->YPos     = tsm1 - collisionMasks[player->collisionPlane].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            uint8 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF000000) >> 24;
-                            sensor->angle    = 0x100 - (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                    }
-                }
-
-                if (sensor->collided) {
-                    if (sensor->angle < 0)
-                        sensor->angle += 0x100;
 
-                    if (sensor->angle > 0xFF)
-                        sensor->angle -= 0x100;
+    LegacyTileSource source = { player->collisionPlane, LEGACY_SOLIDITY_TOP, 0, false, 0 };
+    TileSurface surface;
+    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
+        if (!sensor->collided && source.GetSurface<CMODE_FLOOR>(sensor->XPos >> 16, (sensor->YPos >> 16) - TILE_SIZE + i, &surface)) {
+            sensor->YPos     = surface.pos;
+            sensor->collided = true;
+            sensor->angle    = surface.angle;
 
-                    if ((abs(sensor->angle - angle) > 0x20) && (abs(sensor->angle - 0x100 - angle) > 0x20)
-                        && (abs(sensor->angle + 0x100 - angle) > 0x20)) {
-                        sensor->YPos     = startY << 16;
-                        sensor->collided = false;
-                        sensor->angle    = angle;
-                        i                = TILE_SIZE * 3;
-                    }
-                    else if (sensor->YPos - startY > (TILE_SIZE - 2)) {
-                        sensor->YPos     = startY << 16;
-                        sensor->collided = false;
-                    }
-                    else if (sensor->YPos - startY < -(TILE_SIZE - 2)) {
-                        sensor->YPos     = startY << 16;
-                        sensor->collided = false;
-                    }
-                }
+            if ((abs(sensor->angle - angle) > 0x20) && (abs(sensor->angle - 0x100 - angle) > 0x20) && (abs(sensor->angle + 0x100 - angle) > 0x20)) {
+                sensor->YPos     = startY << 16;
+                sensor->collided = false;
+                sensor->angle    = angle;
+                i                = TILE_SIZE * 3;
+            }
+            else if (sensor->YPos - startY > (TILE_SIZE - 2)) {
+                sensor->YPos     = startY << 16;
+                sensor->collided = false;
+            }
+            else if (sensor->YPos - startY < -(TILE_SIZE - 2)) {
+                sensor->YPos     = startY << 16;
+                sensor->collided = false;
             }
         }
     }
 }
 void RSDK::Legacy::v3::FindLWallPosition(Player *player, CollisionSensor *sensor, int32 startX)
 {
-    int32 c     = 0;
     int32 angle = sensor->angle;
-    int32 tsm1  = (TILE_SIZE - 1);
-    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
-        if (!sensor->collided) {
-            int32 XPos   = (sensor->XPos >> 16) + i - TILE_SIZE;
-            int32 chunkX = XPos >> 7;
-            int32 tileX  = (XPos & 0x7F) >> 4;
-            int32 YPos   = sensor->YPos >> 16;
-            int32 chunkY = YPos >> 7;
-            int32 tileY  = (YPos & 0x7F) >> 4;
-            if (XPos > -1 && YPos > -1) {
-                int32 tile      = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-                tile            = tile + tileX + (tileY << 3);
-                int32 tileIndex = tiles128x128.tileIndex[tile];
-                if (tiles128x128.collisionFlags[player->collisionPlane][tile] < SOLID_NONE) {
-                    switch (tiles128x128.direction[tile]) {
-                        case FLIP_NONE: {
-                            c = (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].lWallMasks[c] >= 0x40)
-                                break;
-
-                            sensor->XPos     = collisionMasks[player->collisionPlane].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            sensor->angle    = ((collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF00) >> 8);
-                            break;
-                        }
-                        case FLIP_X: {
-                            c = (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].rWallMasks[c] <= -0x40)
-                                break;
-
-                            sensor->XPos     = tsm1 - collisionMasks[player->collisionPlane].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            sensor->angle    = 0x100 - ((collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF0000) >> 16);
-                            break;
-                        }
-                        case FLIP_Y: {
-                            c = tsm1 - (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].lWallMasks[c] >= 0x40)
-                                break;
-
-                            sensor->XPos     = collisionMasks[player->collisionPlane].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            int32 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF00) >> 8;
-                            sensor->angle    = (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                        case FLIP_XY: {
-                            c = tsm1 - (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].rWallMasks[c] <= -0x40)
-                                break;
 
-                            sensor->XPos     = tsm1 - collisionMasks[player->collisionPlane].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            int32 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF0000) >> 16;
-                            sensor->angle    = 0x100 - (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                    }
-                }
-                if (sensor->collided) {
-                    if (sensor->angle < 0)
-                        sensor->angle += 0x100;
-
-                    if (sensor->angle > 0xFF)
-                        sensor->angle -= 0x100;
+    LegacyTileSource source = { player->collisionPlane, LEGACY_SOLIDITY_ANY, 0, false, 0 };
+    TileSurface surface;
+    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
+        if (!sensor->collided && source.GetSurface<CMODE_LWALL>((sensor->XPos >> 16) - TILE_SIZE + i, sensor->YPos >> 16, &surface)) {
+            sensor->XPos     = surface.pos;
+            sensor->collided = true;
+            sensor->angle    = surface.angle;
 
-                    if (abs(angle - sensor->angle) > 0x20) {
-                        sensor->XPos     = startX << 16;
-                        sensor->collided = false;
-                        sensor->angle    = angle;
-                        i                = TILE_SIZE * 3;
-                    }
-                    else if (sensor->XPos - startX > TILE_SIZE - 2) {
-                        sensor->XPos     = startX << 16;
-                        sensor->collided = false;
-                    }
-                    else if (sensor->XPos - startX < -(TILE_SIZE - 2)) {
-                        sensor->XPos     = startX << 16;
-                        sensor->collided = false;
-                    }
-                }
+            if (abs(angle - sensor->angle) > 0x20) {
+                sensor->XPos     = startX << 16;
+                sensor->collided = false;
+                sensor->angle    = angle;
+                i                = TILE_SIZE * 3;
+            }
+            else if (sensor->XPos - startX > TILE_SIZE - 2) {
+                sensor->XPos     = startX << 16;
+                sensor->collided = false;
+            }
+            else if (sensor->XPos - startX < -(TILE_SIZE - 2)) {
+                sensor->XPos     = startX << 16;
+                sensor->collided = false;
             }
         }
     }
 }
 void RSDK::Legacy::v3::FindRoofPosition(Player *player, CollisionSensor *sensor, int32 startY)
 {
-    int32 c     = 0;
     int32 angle = sensor->angle;
-    int32 tsm1  = (TILE_SIZE - 1);
-    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
-        if (!sensor->collided) {
-            int32 XPos   = sensor->XPos >> 16;
-            int32 chunkX = XPos >> 7;
-            int32 tileX  = (XPos & 0x7F) >> 4;
-            int32 YPos   = (sensor->YPos >> 16) + TILE_SIZE - i;
-            int32 chunkY = YPos >> 7;
-            int32 tileY  = (YPos & 0x7F) >> 4;
-            if (XPos > -1 && YPos > -1) {
-                int32 tile      = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-                tile            = tile + tileX + (tileY << 3);
-                int32 tileIndex = tiles128x128.tileIndex[tile];
-                if (tiles128x128.collisionFlags[player->collisionPlane][tile] < SOLID_NONE) {
-                    switch (tiles128x128.direction[tile]) {
-                        case FLIP_NONE: {
-                            c = (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].roofMasks[c] <= -0x40)
-                                break;
-
-                            sensor->YPos     = collisionMasks[player->collisionPlane].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            sensor->angle    = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF000000) >> 24;
-                            break;
-                        }
-                        case FLIP_X: {
-                            c = tsm1 - (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].roofMasks[c] <= -0x40)
-                                break;
 
-                            sensor->YPos     = collisionMasks[player->collisionPlane].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            sensor->angle    = 0x100 - ((collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF000000) >> 24);
-                            break;
-                        }
-                        case FLIP_Y: {
-                            c = (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].floorMasks[c] >= 0x40)
-                                break;
-
-                            sensor->YPos     = tsm1 - collisionMasks[player->collisionPlane].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            uint8 cAngle     = collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF;
-                            sensor->angle    = (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                        case FLIP_XY: {
-                            c = tsm1 - (XPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].floorMasks[c] >= 0x40)
-                                break;
+    LegacyTileSource source = { player->collisionPlane, LEGACY_SOLIDITY_ANY, 0, false, 0 };
+    TileSurface surface;
+    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
+        if (!sensor->collided && source.GetSurface<CMODE_ROOF>(sensor->XPos >> 16, (sensor->YPos >> 16) + TILE_SIZE - i, &surface)) {
+            sensor->YPos     = surface.pos;
+            sensor->collided = true;
+            sensor->angle    = surface.angle;
 
-                            sensor->YPos     = tsm1 - collisionMasks[player->collisionPlane].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                            sensor->collided = true;
-                            uint8 cAngle     = collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF;
-                            sensor->angle    = 0x100 - (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                    }
+            if (abs(sensor->angle - angle) <= 0x20) {
+                if (sensor->YPos - startY > TILE_SIZE - 1) {
+                    sensor->YPos     = startY << 16;
+                    sensor->collided = false;
                 }
-
-                if (sensor->collided) {
-                    if (sensor->angle < 0)
-                        sensor->angle += 0x100;
-
-                    if (sensor->angle > 0xFF)
-                        sensor->angle -= 0x100;
-
-                    if (abs(sensor->angle - angle) <= 0x20) {
-                        if (sensor->YPos - startY > tsm1) {
-                            sensor->YPos     = startY << 16;
-                            sensor->collided = false;
-                        }
-                        if (sensor->YPos - startY < -tsm1) {
-                            sensor->YPos     = startY << 16;
-                            sensor->collided = false;
-                        }
-                    }
-                    else {
-                        sensor->YPos     = startY << 16;
-                        sensor->collided = false;
-                        sensor->angle    = angle;
-                        i                = TILE_SIZE * 3;
-                    }
+                if (sensor->YPos - startY < -(TILE_SIZE - 1)) {
+                    sensor->YPos     = startY << 16;
+                    sensor->collided = false;
                 }
             }
+            else {
+                sensor->YPos     = startY << 16;
+                sensor->collided = false;
+                sensor->angle    = angle;
+                i                = TILE_SIZE * 3;
+            }
         }
     }
 }
 void RSDK::Legacy::v3::FindRWallPosition(Player *player, CollisionSensor *sensor, int32 startX)
 {
-    int32 c;
     int32 angle = sensor->angle;
-    int32 tsm1  = (TILE_SIZE - 1);
-    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
-        if (!sensor->collided) {
-            int32 XPos   = (sensor->XPos >> 16) + TILE_SIZE - i;
-            int32 chunkX = XPos >> 7;
-            int32 tileX  = (XPos & 0x7F) >> 4;
-            int32 YPos   = sensor->YPos >> 16;
-            int32 chunkY = YPos >> 7;
-            int32 tileY  = (YPos & 0x7F) >> 4;
-            if (XPos > -1 && YPos > -1) {
-                int32 tile      = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-                tile            = tile + tileX + (tileY << 3);
-                int32 tileIndex = tiles128x128.tileIndex[tile];
-                if (tiles128x128.collisionFlags[player->collisionPlane][tile] < SOLID_NONE) {
-                    switch (tiles128x128.direction[tile]) {
-                        case FLIP_NONE: {
-                            c = (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].rWallMasks[c] <= -0x40)
-                                break;
-
-                            sensor->XPos     = collisionMasks[player->collisionPlane].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            sensor->angle    = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF0000) >> 16;
-                            break;
-                        }
-                        case FLIP_X: {
-                            c = (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].lWallMasks[c] >= 0x40)
-                                break;
-
-                            sensor->XPos     = tsm1 - collisionMasks[player->collisionPlane].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            sensor->angle    = 0x100 - ((collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF00) >> 8);
-                            break;
-                        }
-                        case FLIP_Y: {
-                            c = tsm1 - (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].rWallMasks[c] <= -0x40)
-                                break;
-
-                            sensor->XPos     = collisionMasks[player->collisionPlane].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            int32 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF0000) >> 16;
-                            sensor->angle    = (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                        case FLIP_XY: {
-                            c = tsm1 - (YPos & tsm1) + (tileIndex << 4);
-                            if (collisionMasks[player->collisionPlane].lWallMasks[c] >= 0x40)
-                                break;
 
-                            sensor->XPos     = tsm1 - collisionMasks[player->collisionPlane].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                            sensor->collided = true;
-                            int32 cAngle     = (collisionMasks[player->collisionPlane].angles[tileIndex] & 0xFF00) >> 8;
-                            sensor->angle    = 0x100 - (uint8)(-0x80 - cAngle);
-                            break;
-                        }
-                    }
-                }
-                if (sensor->collided) {
-                    if (sensor->angle < 0)
-                        sensor->angle += 0x100;
-
-                    if (sensor->angle > 0xFF)
-                        sensor->angle -= 0x100;
+    LegacyTileSource source = { player->collisionPlane, LEGACY_SOLIDITY_ANY, 0, false, 0 };
+    TileSurface surface;
+    for (int32 i = 0; i < TILE_SIZE * 3; i += TILE_SIZE) {
+        if (!sensor->collided && source.GetSurface<CMODE_RWALL>((sensor->XPos >> 16) + TILE_SIZE - i, sensor->YPos >> 16, &surface)) {
+            sensor->XPos     = surface.pos;
+            sensor->collided = true;
+            sensor->angle    = surface.angle;
 
-                    if (abs(sensor->angle - angle) > 0x20) {
-                        sensor->XPos     = startX << 16;
-                        sensor->collided = false;
-                        sensor->angle    = angle;
-                        i                = TILE_SIZE * 3;
-                    }
-                    else if (sensor->XPos - startX > (TILE_SIZE - 2)) {
-                        sensor->XPos     = startX >> 16;
-                        sensor->collided = false;
-                    }
-                    else if (sensor->XPos - startX < -(TILE_SIZE - 2)) {
-                        sensor->XPos     = startX << 16;
-                        sensor->collided = false;
-                    }
-                }
+            if (abs(sensor->angle - angle) > 0x20) {
+                sensor->XPos     = startX << 16;
+                sensor->collided = false;
+                sensor->angle    = angle;
+                i                = TILE_SIZE * 3;
+            }
+            else if (sensor->XPos - startX > (TILE_SIZE - 2)) {
+                sensor->XPos     = startX >> 16;
+                sensor->collided = false;
+            }
+            else if (sensor->XPos - startX < -(TILE_SIZE - 2)) {
+                sensor->XPos     = startX << 16;
+                sensor->collided = false;
             }
         }
     }
@@ -1625,518 +1381,149 @@ void RSDK::Legacy::v3::ObjectFloorCollision(int32 xOffset, int32 yOffset, int32
 {
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
-    int32 c               = 0;
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7) {
-        int32 chunkX    = XPos >> 7;
-        int32 tileX     = (XPos & 0x7F) >> 4;
-        int32 chunkY    = YPos >> 7;
-        int32 tileY     = (YPos & 0x7F) >> 4;
-        int32 chunk     = (stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6) + tileX + (tileY << 3);
-        int32 tileIndex = tiles128x128.tileIndex[chunk];
-        if (tiles128x128.collisionFlags[cPath][chunk] != SOLID_LRB && tiles128x128.collisionFlags[cPath][chunk] != SOLID_NONE) {
-            switch (tiles128x128.direction[chunk]) {
-                case 0: {
-                    c = (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) <= collisionMasks[cPath].floorMasks[c]) {
-                        break;
-                    }
-                    YPos                  = collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 1: {
-                    c = 15 - (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) <= collisionMasks[cPath].floorMasks[c]) {
-                        break;
-                    }
-                    YPos                  = collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 2: {
-                    c = (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) <= 15 - collisionMasks[cPath].roofMasks[c]) {
-                        break;
-                    }
-                    YPos                  = 15 - collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 3: {
-                    c = 15 - (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) <= 15 - collisionMasks[cPath].roofMasks[c]) {
-                        break;
-                    }
-                    YPos                  = 15 - collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-            }
-        }
-        if (scriptEng.checkResult) {
-            entity->YPos = (YPos - yOffset) << 16;
-        }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_TOP, 1, true, 0 };
+    TileSurface surface;
+    if (source.GetSurface<CMODE_FLOOR>(XPos, YPos, &surface) && YPos > surface.pos) {
+        entity->YPos          = (surface.pos - yOffset) << 16;
+        scriptEng.checkResult = true;
     }
 }
 void RSDK::Legacy::v3::ObjectLWallCollision(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7) {
-        int32 chunkX    = XPos >> 7;
-        int32 tileX     = (XPos & 0x7F) >> 4;
-        int32 chunkY    = YPos >> 7;
-        int32 tileY     = (YPos & 0x7F) >> 4;
-        int32 chunk     = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-        chunk           = chunk + tileX + (tileY << 3);
-        int32 tileIndex = tiles128x128.tileIndex[chunk];
-        if (tiles128x128.collisionFlags[cPath][chunk] != SOLID_TOP && tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-            switch (tiles128x128.direction[chunk]) {
-                case 0: {
-                    c = (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) <= collisionMasks[cPath].lWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 1: {
-                    c = (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) <= 15 - collisionMasks[cPath].rWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = 15 - collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 2: {
-                    c = 15 - (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) <= collisionMasks[cPath].lWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 3: {
-                    c = 15 - (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) <= 15 - collisionMasks[cPath].rWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = 15 - collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-            }
-        }
-        if (scriptEng.checkResult) {
-            entity->XPos = (XPos - xOffset) << 16;
-        }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_LRB, 1, true, 0 };
+    TileSurface surface;
+    if (source.GetSurface<CMODE_LWALL>(XPos, YPos, &surface) && XPos > surface.pos) {
+        entity->XPos          = (surface.pos - xOffset) << 16;
+        scriptEng.checkResult = true;
     }
 }
 void RSDK::Legacy::v3::ObjectRoofCollision(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7) {
-        int32 chunkX    = XPos >> 7;
-        int32 tileX     = (XPos & 0x7F) >> 4;
-        int32 chunkY    = YPos >> 7;
-        int32 tileY     = (YPos & 0x7F) >> 4;
-        int32 chunk     = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-        chunk           = chunk + tileX + (tileY << 3);
-        int32 tileIndex = tiles128x128.tileIndex[chunk];
-        if (tiles128x128.collisionFlags[cPath][chunk] != SOLID_TOP && tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-            switch (tiles128x128.direction[chunk]) {
-                case 0: {
-                    c = (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) >= collisionMasks[cPath].roofMasks[c]) {
-                        break;
-                    }
-                    YPos                  = collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 1: {
-                    c = 15 - (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) >= collisionMasks[cPath].roofMasks[c]) {
-                        break;
-                    }
-                    YPos                  = collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 2: {
-                    c = (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) >= 15 - collisionMasks[cPath].floorMasks[c]) {
-                        break;
-                    }
-                    YPos                  = 15 - collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 3: {
-                    c = 15 - (XPos & 15) + (tileIndex << 4);
-                    if ((YPos & 15) >= 15 - collisionMasks[cPath].floorMasks[c]) {
-                        break;
-                    }
-                    YPos                  = 15 - collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-            }
-        }
-        if (scriptEng.checkResult) {
-            entity->YPos = (YPos - yOffset) << 16;
-        }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_LRB, 1, true, 0 };
+    TileSurface surface;
+    if (source.GetSurface<CMODE_ROOF>(XPos, YPos, &surface) && YPos < surface.pos) {
+        entity->YPos          = (surface.pos - yOffset) << 16;
+        scriptEng.checkResult = true;
     }
 }
 void RSDK::Legacy::v3::ObjectRWallCollision(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7) {
-        int32 chunkX    = XPos >> 7;
-        int32 tileX     = (XPos & 0x7F) >> 4;
-        int32 chunkY    = YPos >> 7;
-        int32 tileY     = (YPos & 0x7F) >> 4;
-        int32 chunk     = stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6;
-        chunk           = chunk + tileX + (tileY << 3);
-        int32 tileIndex = tiles128x128.tileIndex[chunk];
-        if (tiles128x128.collisionFlags[cPath][chunk] != SOLID_TOP && tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-            switch (tiles128x128.direction[chunk]) {
-                case 0: {
-                    c = (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) >= collisionMasks[cPath].rWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 1: {
-                    c = (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) >= 15 - collisionMasks[cPath].lWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = 15 - collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 2: {
-                    c = 15 - (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) >= collisionMasks[cPath].rWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-                case 3: {
-                    c = 15 - (YPos & 15) + (tileIndex << 4);
-                    if ((XPos & 15) >= 15 - collisionMasks[cPath].lWallMasks[c]) {
-                        break;
-                    }
-                    XPos                  = 15 - collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                    scriptEng.checkResult = true;
-                    break;
-                }
-            }
-        }
-        if (scriptEng.checkResult) {
-            entity->XPos = (XPos - xOffset) << 16;
-        }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_LRB, 1, true, 0 };
+    TileSurface surface;
+    if (source.GetSurface<CMODE_RWALL>(XPos, YPos, &surface) && XPos < surface.pos) {
+        entity->XPos          = (surface.pos - xOffset) << 16;
+        scriptEng.checkResult = true;
     }
 }
 
 void RSDK::Legacy::v3::ObjectFloorGrip(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    int32 chunkX          = YPos;
-    YPos                  = YPos - 16;
-    for (int32 i = 3; i > 0; i--) {
-        if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7 && !scriptEng.checkResult) {
-            int32 chunkX    = XPos >> 7;
-            int32 tileX     = (XPos & 0x7F) >> 4;
-            int32 chunkY    = YPos >> 7;
-            int32 tileY     = (YPos & 0x7F) >> 4;
-            int32 chunk     = (stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6) + tileX + (tileY << 3);
-            int32 tileIndex = tiles128x128.tileIndex[chunk];
-            if (tiles128x128.collisionFlags[cPath][chunk] != SOLID_LRB && tiles128x128.collisionFlags[cPath][chunk] != SOLID_NONE) {
-                switch (tiles128x128.direction[chunk]) {
-                    case 0: {
-                        c = (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].floorMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->YPos          = collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 1: {
-                        c = 15 - (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].floorMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->YPos          = collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 2: {
-                        c = (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].roofMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->YPos          = 15 - collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 3: {
-                        c = 15 - (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].roofMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->YPos          = 15 - collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                }
-            }
-        }
-        YPos += 16;
-    }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_TOP, 1, true, 0 };
+    SweepTileSurfaces<CMODE_FLOOR>(source, XPos, YPos, 3, [entity](TileSurface &surface) {
+        entity->YPos          = surface.pos;
+        scriptEng.checkResult = true;
+        return true;
+    });
+
     if (scriptEng.checkResult) {
-        if (abs(entity->YPos - chunkX) < 16) {
+        if (abs(entity->YPos - YPos) < 16) {
             entity->YPos = (entity->YPos - yOffset) << 16;
             return;
         }
-        entity->YPos          = (chunkX - yOffset) << 16;
+        entity->YPos          = (YPos - yOffset) << 16;
         scriptEng.checkResult = false;
     }
 }
 void RSDK::Legacy::v3::ObjectLWallGrip(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    int32 startX          = XPos;
-    XPos                  = XPos - 16;
-    int32 chunk           = xOffset;
-    for (int32 i = 3; i > 0; i--) {
-        if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7 && !scriptEng.checkResult) {
-            int32 chunkX    = XPos >> 7;
-            int32 tileX     = (XPos & 0x7F) >> 4;
-            int32 chunkY    = YPos >> 7;
-            int32 tileY     = (YPos & 0x7F) >> 4;
-            chunk           = (stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6) + tileX + (tileY << 3);
-            int32 tileIndex = tiles128x128.tileIndex[chunk];
-            if (tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-                switch (tiles128x128.direction[chunk]) {
-                    case 0: {
-                        c = (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].lWallMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->XPos          = collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 1: {
-                        c = (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].rWallMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->XPos          = 15 - collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 2: {
-                        c = 15 - (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].lWallMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->XPos          = collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 3: {
-                        c = 15 - (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].rWallMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->XPos          = 15 - collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                }
-            }
-        }
-        XPos += 16;
-    }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_ANY, 1, true, 0 };
+    SweepTileSurfaces<CMODE_LWALL>(source, XPos, YPos, 3, [entity](TileSurface &surface) {
+        entity->XPos          = surface.pos;
+        scriptEng.checkResult = true;
+        return true;
+    });
+
     if (scriptEng.checkResult) {
-        if (abs(entity->XPos - startX) < 16) {
+        if (abs(entity->XPos - XPos) < 16) {
             entity->XPos = (entity->XPos - xOffset) << 16;
             return;
         }
-        entity->XPos          = (startX - xOffset) << 16;
-        scriptEng.checkResult = tiles128x128.collisionFlags[cPath][chunk] == 1;
+        entity->XPos          = (XPos - xOffset) << 16;
+        scriptEng.checkResult = tiles128x128.collisionFlags[cPath][source.chunk] == 1;
     }
 }
 void RSDK::Legacy::v3::ObjectRoofGrip(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    int32 startY          = YPos;
-    YPos                  = YPos + 16;
-    for (int32 i = 3; i > 0; i--) {
-        if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7 && !scriptEng.checkResult) {
-            int32 chunkX    = XPos >> 7;
-            int32 tileX     = (XPos & 0x7F) >> 4;
-            int32 chunkY    = YPos >> 7;
-            int32 tileY     = (YPos & 0x7F) >> 4;
-            int32 chunk     = (stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6) + tileX + (tileY << 3);
-            int32 tileIndex = tiles128x128.tileIndex[chunk];
-            if (tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-                switch (tiles128x128.direction[chunk]) {
-                    case 0: {
-                        c = (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].roofMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->YPos          = collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 1: {
-                        c = 15 - (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].roofMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->YPos          = collisionMasks[cPath].roofMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 2: {
-                        c = (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].floorMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->YPos          = 15 - collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 3: {
-                        c = 15 - (XPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].floorMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->YPos          = 15 - collisionMasks[cPath].floorMasks[c] + (chunkY << 7) + (tileY << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                }
-            }
-        }
-        YPos -= 16;
-    }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_ANY, 1, true, 0 };
+    SweepTileSurfaces<CMODE_ROOF>(source, XPos, YPos, 3, [entity](TileSurface &surface) {
+        entity->YPos          = surface.pos;
+        scriptEng.checkResult = true;
+        return true;
+    });
+
     if (scriptEng.checkResult) {
-        if (abs(entity->YPos - startY) < 16) {
+        if (abs(entity->YPos - YPos) < 16) {
             entity->YPos = (entity->YPos - yOffset) << 16;
             return;
         }
-        entity->YPos          = (startY - yOffset) << 16;
+        entity->YPos          = (YPos - yOffset) << 16;
         scriptEng.checkResult = false;
     }
 }
 void RSDK::Legacy::v3::ObjectRWallGrip(int32 xOffset, int32 yOffset, int32 cPath)
 {
-    int32 c;
     scriptEng.checkResult = false;
     Entity *entity        = &objectEntityList[objectLoop];
     int32 XPos            = (entity->XPos >> 16) + xOffset;
     int32 YPos            = (entity->YPos >> 16) + yOffset;
-    int32 startX          = XPos;
-    XPos                  = XPos + 16;
-    int32 chunk           = xOffset;
-    for (int32 i = 3; i > 0; i--) {
-        if (XPos > 0 && XPos < stageLayouts[0].xsize << 7 && YPos > 0 && YPos < stageLayouts[0].ysize << 7 && !scriptEng.checkResult) {
-            int32 chunkX    = XPos >> 7;
-            int32 tileX     = (XPos & 0x7F) >> 4;
-            int32 chunkY    = YPos >> 7;
-            int32 tileY     = (YPos & 0x7F) >> 4;
-            chunk           = (stageLayouts[0].tiles[chunkX + (chunkY << 8)] << 6) + tileX + (tileY << 3);
-            int32 tileIndex = tiles128x128.tileIndex[chunk];
-            if (tiles128x128.collisionFlags[cPath][chunk] < SOLID_NONE) {
-                switch (tiles128x128.direction[chunk]) {
-                    case 0: {
-                        c = (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].rWallMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->XPos          = collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 1: {
-                        c = (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].lWallMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->XPos          = 15 - collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 2: {
-                        c = 15 - (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].rWallMasks[c] <= -64) {
-                            break;
-                        }
-                        entity->XPos          = collisionMasks[cPath].rWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                    case 3: {
-                        c = 15 - (YPos & 15) + (tileIndex << 4);
-                        if (collisionMasks[cPath].lWallMasks[c] >= 64) {
-                            break;
-                        }
-                        entity->XPos          = 15 - collisionMasks[cPath].lWallMasks[c] + (chunkX << 7) + (tileX << 4);
-                        scriptEng.checkResult = true;
-                        break;
-                    }
-                }
-            }
-        }
-        XPos -= 16;
-    }
+
+    LegacyTileSource source = { cPath, LEGACY_SOLIDITY_ANY, 1, true, 0 };
+    SweepTileSurfaces<CMODE_RWALL>(source, XPos, YPos, 3, [entity](TileSurface &surface) {
+        entity->XPos          = surface.pos;
+        scriptEng.checkResult = true;
+        return true;
+    });
+
     if (scriptEng.checkResult) {
-        if (abs(entity->XPos - startX) < 16) {
+        if (abs(entity->XPos - XPos) < 16) {
             entity->XPos = (entity->XPos - xOffset) << 16;
             return;
         }
-        entity->XPos          = (startX - xOffset) << 16;
-        scriptEng.checkResult = tiles128x128.collisionFlags[cPath][chunk] == 1;
+        entity->XPos          = (XPos - xOffset) << 16;
+        scriptEng.checkResult = tiles128x128.collisionFlags[cPath][source.chunk] == 1;
     }
 }
 
@@ -15,16 +15,507 @@ int32 RSDK::stageObjectIDs[OBJECT_COUNT];
 
 EntityBase RSDK::objectEntityList[ENTITY_COUNT];
 
+#if RETRO_USE_LIVE_ENTITY_LIST
+uint64 RSDK::liveEntitySlots[LIVEENTITY_WORD_COUNT];
+#endif
+#if RETRO_USE_ENTITY_HOT_FIELDS
+uint64 RSDK::entityHotSlots[LIVEENTITY_WORD_COUNT];
+uint64 RSDK::entityHotSkip[LIVEENTITY_WORD_COUNT];
+#endif
+#if RETRO_USE_CLASS_ENTITY_LIST
+uint64 RSDK::classEntitySlots[OBJECT_COUNT][CLASSENTITY_WORD_COUNT];
+#endif
+
 EditableVarInfo *RSDK::editableVarList;
 int32 RSDK::editableVarCount = 0;
 
 TypeGroupList RSDK::typeGroups[TYPEGROUP_COUNT];
 
-bool32 RSDK::validDraw = false;
+RETRO_RENDER_TLS bool32 RSDK::validDraw = false;
 
 ForeachStackInfo RSDK::foreachStackList[FOREACH_STACK_COUNT];
 ForeachStackInfo *RSDK::foreachStackPtr = NULL;
 
+// index of the lowest set bit, "bits" can't be 0
+static inline int32 GetLowestEntityBit(uint64 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int32 bit = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+#if RETRO_USE_CLASS_ENTITY_LIST
+void RSDK::RefreshClassEntities()
+{
+    memset(classEntitySlots, 0, sizeof(classEntitySlots));
+
+    for (int32 e = 0; e < ENTITY_COUNT; ++e) AddClassEntity(e, objectEntityList[e].classID);
+}
+#endif
+
+#if RETRO_USE_LIVE_ENTITY_LIST
+void RSDK::RefreshLiveEntities()
+{
+    memset(liveEntitySlots, 0, sizeof(liveEntitySlots));
+
+    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
+        if (objectEntityList[e].classID)
+            AddLiveEntity(e);
+    }
+}
+
+static inline uint64 GetLiveEntityWord(int32 word) { return liveEntitySlots[word]; }
+
+// the next slot after "slot" that GetWord() has a bit set for (pass -1 to get the first one), or -1 once there's none left
+// the bits are re-read every time, so anything created further ahead mid-loop still gets visited that frame like it would when walking every slot
+template <uint64 (*GetWord)(int32)> static inline int32 GetNextEntitySlot(int32 slot)
+{
+    ++slot;
+
+    int32 word = slot >> 6;
+    if (word >= LIVEENTITY_WORD_COUNT)
+        return -1;
+
+    uint64 bits = GetWord(word) & (~(uint64)0 << (slot & 63));
+    while (!bits) {
+        if (++word >= LIVEENTITY_WORD_COUNT)
+            return -1;
+
+        bits = GetWord(word);
+    }
+
+    return (word << 6) + GetLowestEntityBit(bits);
+}
+
+static inline int32 GetNextLiveEntity(int32 slot) { return GetNextEntitySlot<GetLiveEntityWord>(slot); }
+#else
+static inline int32 GetNextLiveEntity(int32 slot) { return slot + 1 < ENTITY_COUNT ? slot + 1 : -1; }
+#endif
+
+#if RETRO_USE_ENTITY_HOT_FIELDS
+#if RETRO_SIMD_SSE2
+#include <emmintrin.h>
+#elif RETRO_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+#define HOTFIELD_COUNT ((ENTITY_COUNT + 3) & ~3)
+// slots that never get skipped no matter what the mirror says, moving along every frame so anything that's been moved or had its
+// active/updateRange changed by another object while it was being skipped gets picked back up within 16 frames
+#define HOTFIELD_SWEEP_SIZE ((HOTFIELD_COUNT + 15) / 16)
+
+// a copy of what the culling switch reads from each entity, taken once it's done for the frame (& it's still in cache)
+// kept as separate arrays so working out every entity's range only has to stream through these instead of every EntityBase
+struct EntityHotFields {
+    alignas(16) int32 positionX[HOTFIELD_COUNT];
+    alignas(16) int32 positionY[HOTFIELD_COUNT];
+    alignas(16) int32 updateRangeX[HOTFIELD_COUNT];
+    alignas(16) int32 updateRangeY[HOTFIELD_COUNT];
+    uint16 classID[HOTFIELD_COUNT];
+    uint8 active[HOTFIELD_COUNT];
+    uint8 inRange[HOTFIELD_COUNT];
+};
+
+static EntityHotFields entityHotFields;
+static int32 entityHotSweepPos = 0;
+
+static void ResetEntityHotFields()
+{
+    memset(entityHotSlots, 0, sizeof(entityHotSlots));
+    memset(entityHotSkip, 0, sizeof(entityHotSkip));
+}
+
+static inline void SyncEntityHotFields(int32 slot)
+{
+    EntityBase *entity = &objectEntityList[slot];
+
+    entityHotFields.positionX[slot]    = entity->position.x;
+    entityHotFields.positionY[slot]    = entity->position.y;
+    entityHotFields.updateRangeX[slot] = entity->updateRange.x;
+    entityHotFields.updateRangeY[slot] = entity->updateRange.y;
+    entityHotFields.classID[slot]      = entity->classID;
+    entityHotFields.active[slot]       = entity->active;
+    entityHotFields.inRange[slot]      = entity->inRange ? 1 : 0;
+
+    entityHotSlots[slot >> 6] |= (uint64)1 << (slot & 63);
+}
+
+// sets bits 0-3 of "bounds", "xBounds" & "yBounds" for whichever of the 4 entities starting at "slot" are in range of a camera for that type
+static inline void GetEntityHotRanges(int32 slot, int32 *bounds, int32 *xBounds, int32 *yBounds)
+{
+#if RETRO_SIMD_SSE2
+    __m128i posX   = _mm_load_si128((const __m128i *)&entityHotFields.positionX[slot]);
+    __m128i posY   = _mm_load_si128((const __m128i *)&entityHotFields.positionY[slot]);
+    __m128i rangeX = _mm_load_si128((const __m128i *)&entityHotFields.updateRangeX[slot]);
+    __m128i rangeY = _mm_load_si128((const __m128i *)&entityHotFields.updateRangeY[slot]);
+
+    __m128i inBounds = _mm_setzero_si128();
+    __m128i inX      = _mm_setzero_si128();
+    __m128i inY      = _mm_setzero_si128();
+    for (int32 s = 0; s < cameraCount; ++s) {
+        // abs(), wrapping the same way the scalar one does
+        __m128i distX = _mm_sub_epi32(posX, _mm_set1_epi32(cameras[s].position.x));
+        __m128i distY = _mm_sub_epi32(posY, _mm_set1_epi32(cameras[s].position.y));
+        __m128i signX = _mm_srai_epi32(distX, 31);
+        __m128i signY = _mm_srai_epi32(distY, 31);
+        distX         = _mm_sub_epi32(_mm_xor_si128(distX, signX), signX);
+        distY         = _mm_sub_epi32(_mm_xor_si128(distY, signY), signY);
+
+        // dist <= range is !(dist > range)
+        __m128i outX = _mm_cmpgt_epi32(distX, _mm_add_epi32(rangeX, _mm_set1_epi32(cameras[s].offset.x)));
+        __m128i outY = _mm_cmpgt_epi32(distY, _mm_add_epi32(rangeY, _mm_set1_epi32(cameras[s].offset.y)));
+
+        inBounds = _mm_or_si128(inBounds, _mm_andnot_si128(_mm_or_si128(outX, outY), _mm_set1_epi32(-1)));
+        inX      = _mm_or_si128(inX, _mm_andnot_si128(outX, _mm_set1_epi32(-1)));
+        inY      = _mm_or_si128(inY, _mm_andnot_si128(outY, _mm_set1_epi32(-1)));
+    }
+
+    *bounds  = _mm_movemask_ps(_mm_castsi128_ps(inBounds));
+    *xBounds = _mm_movemask_ps(_mm_castsi128_ps(inX));
+    *yBounds = _mm_movemask_ps(_mm_castsi128_ps(inY));
+#elif RETRO_SIMD_NEON
+    int32x4_t posX   = vld1q_s32(&entityHotFields.positionX[slot]);
+    int32x4_t posY   = vld1q_s32(&entityHotFields.positionY[slot]);
+    int32x4_t rangeX = vld1q_s32(&entityHotFields.updateRangeX[slot]);
+    int32x4_t rangeY = vld1q_s32(&entityHotFields.updateRangeY[slot]);
+
+    uint32x4_t inBounds = vdupq_n_u32(0);
+    uint32x4_t inX      = vdupq_n_u32(0);
+    uint32x4_t inY      = vdupq_n_u32(0);
+    for (int32 s = 0; s < cameraCount; ++s) {
+        int32x4_t distX = vabsq_s32(vsubq_s32(posX, vdupq_n_s32(cameras[s].position.x)));
+        int32x4_t distY = vabsq_s32(vsubq_s32(posY, vdupq_n_s32(cameras[s].position.y)));
+
+        uint32x4_t okX = vcleq_s32(distX, vaddq_s32(rangeX, vdupq_n_s32(cameras[s].offset.x)));
+        uint32x4_t okY = vcleq_s32(distY, vaddq_s32(rangeY, vdupq_n_s32(cameras[s].offset.y)));
+
+        inBounds = vorrq_u32(inBounds, vandq_u32(okX, okY));
+        inX      = vorrq_u32(inX, okX);
+        inY      = vorrq_u32(inY, okY);
+    }
+
+    // no movemask on NEON (& vaddvq is aarch64 only), so just pull the lanes back out
+    uint32 lanes[3][4];
+    vst1q_u32(lanes[0], inBounds);
+    vst1q_u32(lanes[1], inX);
+    vst1q_u32(lanes[2], inY);
+
+    *bounds  = 0;
+    *xBounds = 0;
+    *yBounds = 0;
+    for (int32 l = 0; l < 4; ++l) {
+        *bounds |= (lanes[0][l] & 1) << l;
+        *xBounds |= (lanes[1][l] & 1) << l;
+        *yBounds |= (lanes[2][l] & 1) << l;
+    }
+#else
+    *bounds  = 0;
+    *xBounds = 0;
+    *yBounds = 0;
+    for (int32 l = 0; l < 4; ++l) {
+        for (int32 s = 0; s < cameraCount; ++s) {
+            int32 sx   = abs(entityHotFields.positionX[slot + l] - cameras[s].position.x);
+            int32 sy   = abs(entityHotFields.positionY[slot + l] - cameras[s].position.y);
+            bool32 okX = sx <= entityHotFields.updateRangeX[slot + l] + cameras[s].offset.x;
+            bool32 okY = sy <= entityHotFields.updateRangeY[slot + l] + cameras[s].offset.y;
+
+            *bounds |= (okX && okY) << l;
+            *xBounds |= okX << l;
+            *yBounds |= okY << l;
+        }
+    }
+#endif
+}
+
+// works out which mirrored ACTIVE_BOUNDS/XBOUNDS/YBOUNDS entities were out of range last frame & still are, so ProcessObjects can leave them be
+// anything else (or that's been reset since it was mirrored, or is in this frame's sweep) always gets the usual treatment, so entities that
+// aren't updating (ACTIVE_NEVER/PAUSED/DISABLED) still notice straight away when another object wakes them up
+static void UpdateEntityHotRanges()
+{
+    PROFILE_SCOPE("UpdateEntityHotRanges");
+
+    memset(entityHotSkip, 0, sizeof(entityHotSkip));
+
+    int32 sweepStart  = entityHotSweepPos;
+    entityHotSweepPos = (entityHotSweepPos + HOTFIELD_SWEEP_SIZE) % HOTFIELD_COUNT;
+
+    for (int32 slot = 0; slot < HOTFIELD_COUNT; slot += 4) {
+        uint64 hotBits = (entityHotSlots[slot >> 6] >> (slot & 63)) & 0xF;
+        if (!hotBits)
+            continue;
+
+        int32 bounds = 0, xBounds = 0, yBounds = 0;
+        GetEntityHotRanges(slot, &bounds, &xBounds, &yBounds);
+
+        for (int32 l = 0; l < 4; ++l) {
+            int32 e = slot + l;
+            if (!((hotBits >> l) & 1) || !entityHotFields.classID[e] || entityHotFields.inRange[e])
+                continue;
+
+            if ((e - sweepStart + HOTFIELD_COUNT) % HOTFIELD_COUNT < HOTFIELD_SWEEP_SIZE)
+                continue;
+
+            bool32 outOfRange = false;
+            switch (entityHotFields.active[e]) {
+                default: break;
+
+                case ACTIVE_BOUNDS: outOfRange = !((bounds >> l) & 1); break;
+                case ACTIVE_XBOUNDS: outOfRange = !((xBounds >> l) & 1); break;
+                case ACTIVE_YBOUNDS: outOfRange = !((yBounds >> l) & 1); break;
+            }
+
+            if (outOfRange)
+                entityHotSkip[e >> 6] |= (uint64)1 << (e & 63);
+        }
+    }
+}
+#endif
+
+#if RETRO_USE_ENTITY_HOT_FIELDS
+// every live entity that isn't known to be staying out of range
+static inline uint64 GetEntityCandidateWord(int32 word) { return liveEntitySlots[word] & ~entityHotSkip[word]; }
+static inline int32 GetNextEntityCandidate(int32 slot) { return GetNextEntitySlot<GetEntityCandidateWord>(slot); }
+#else
+static inline int32 GetNextEntityCandidate(int32 slot) { return GetNextLiveEntity(slot); }
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// everything in typeGroups[GROUP_ALL] binned by position into 128px cells, which are hashed into BROADPHASE_BUCKET_COUNT buckets (so cells far
+// apart can share a bucket), it's only built the first time it gets queried after the typeGroups change so nothing's paid for it unless it's used
+#define BROADPHASE_CELL_SHIFT   (23) // 128px, in fixed point
+#define BROADPHASE_BUCKET_SIZE  (32)
+#define BROADPHASE_BUCKET_COUNT (BROADPHASE_BUCKET_SIZE * BROADPHASE_BUCKET_SIZE)
+// queries look this much further out, so entities that've moved since the broadphase was built still get found
+#define BROADPHASE_MARGIN TO_FIXED(0x40)
+
+#define BROADPHASE_WORD_COUNT ((ENTITY_COUNT + 63) / 64)
+
+// broadphaseStart[b] to broadphaseStart[b + 1] is the range of broadphaseEntries that's in bucket b
+static uint16 broadphaseStart[BROADPHASE_BUCKET_COUNT + 1];
+static uint16 broadphaseEntries[ENTITY_COUNT];
+static bool32 broadphaseDirty = true;
+
+static inline int32 GetBroadphaseBucket(int32 cellX, int32 cellY)
+{
+    return ((cellY & (BROADPHASE_BUCKET_SIZE - 1)) * BROADPHASE_BUCKET_SIZE) + (cellX & (BROADPHASE_BUCKET_SIZE - 1));
+}
+
+void RSDK::ResetEntityBroadphase() { broadphaseDirty = true; }
+
+static void BuildEntityBroadphase()
+{
+    TypeGroupList *list = &typeGroups[GROUP_ALL];
+    uint16 bucketPos[BROADPHASE_BUCKET_COUNT];
+
+    memset(broadphaseStart, 0, sizeof(broadphaseStart));
+    for (int32 i = 0; i < list->entryCount; ++i) {
+        EntityBase *entity = &objectEntityList[list->entries[i]];
+        broadphaseStart[GetBroadphaseBucket(entity->position.x >> BROADPHASE_CELL_SHIFT, entity->position.y >> BROADPHASE_CELL_SHIFT) + 1]++;
+    }
+
+    for (int32 b = 0; b < BROADPHASE_BUCKET_COUNT; ++b) broadphaseStart[b + 1] += broadphaseStart[b];
+    memcpy(bucketPos, broadphaseStart, sizeof(bucketPos));
+
+    for (int32 i = 0; i < list->entryCount; ++i) {
+        EntityBase *entity = &objectEntityList[list->entries[i]];
+        int32 bucket       = GetBroadphaseBucket(entity->position.x >> BROADPHASE_CELL_SHIFT, entity->position.y >> BROADPHASE_CELL_SHIFT);
+        broadphaseEntries[bucketPos[bucket]++] = list->entries[i];
+    }
+
+    broadphaseDirty = false;
+}
+
+// sets a bit in "slots" for every entity binned near the rect, the caller still has to check their actual positions
+// the rect's 64-bit so callers can pad positions near the edges of the int32 range without them wrapping around
+static void GetBroadphaseCandidates(int64 left, int64 top, int64 right, int64 bottom, uint64 *slots)
+{
+    if (broadphaseDirty)
+        BuildEntityBroadphase();
+
+    memset(slots, 0, sizeof(uint64) * BROADPHASE_WORD_COUNT);
+
+    int32 cellLeft   = (int32)((left - BROADPHASE_MARGIN) >> BROADPHASE_CELL_SHIFT);
+    int32 cellTop    = (int32)((top - BROADPHASE_MARGIN) >> BROADPHASE_CELL_SHIFT);
+    int32 cellRight  = (int32)((right + BROADPHASE_MARGIN) >> BROADPHASE_CELL_SHIFT);
+    int32 cellBottom = (int32)((bottom + BROADPHASE_MARGIN) >> BROADPHASE_CELL_SHIFT);
+
+    // the buckets wrap around, so going any wider than the table would only visit the same ones again
+    if (cellRight - cellLeft >= BROADPHASE_BUCKET_SIZE) {
+        cellLeft  = 0;
+        cellRight = BROADPHASE_BUCKET_SIZE - 1;
+    }
+    if (cellBottom - cellTop >= BROADPHASE_BUCKET_SIZE) {
+        cellTop    = 0;
+        cellBottom = BROADPHASE_BUCKET_SIZE - 1;
+    }
+
+    for (int32 cy = cellTop; cy <= cellBottom; ++cy) {
+        for (int32 cx = cellLeft; cx <= cellRight; ++cx) {
+            int32 bucket = GetBroadphaseBucket(cx, cy);
+            for (int32 i = broadphaseStart[bucket]; i < broadphaseStart[bucket + 1]; ++i) {
+                int32 slot = broadphaseEntries[i];
+                slots[slot >> 6] |= (uint64)1 << (slot & 63);
+            }
+        }
+    }
+}
+
+static inline bool32 CheckBroadphaseGroup(EntityBase *entity, uint16 group)
+{
+    if (group == GROUP_ALL)
+        return entity->classID != TYPE_DEFAULTOBJECT;
+    else if (group < TYPE_COUNT)
+        return entity->classID == group;
+    else
+        return entity->group == group;
+}
+#endif
+
+#if !RETRO_USE_ORIGINAL_CODE
+// entities of parallel-safe classes that are waiting for RunParallelUpdates, in slot order
+static uint16 parallelUpdateSlots[ENTITY_COUNT];
+static int32 parallelUpdateCount = 0;
+
+static void RunParallelUpdateBatch(void *data, int32 start, int32 end)
+{
+    uint16 *slots = (uint16 *)data;
+
+    for (int32 i = start; i < end; ++i) {
+        EntityBase *entity = &objectEntityList[slots[i]];
+
+        // something else might've reset it to another class since it was queued
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[entity->classID]];
+        if (entity->classID && classInfo->parallelUpdate)
+            classInfo->parallelUpdate(entity);
+    }
+}
+
+static void RunParallelUpdates()
+{
+    if (!parallelUpdateCount)
+        return;
+
+    PROFILE_SCOPE("ParallelUpdate");
+    ParallelFor(parallelUpdateCount, 0, RunParallelUpdateBatch, parallelUpdateSlots);
+    parallelUpdateCount = 0;
+}
+
+// entities of classes that update in batches, in slot order until RunBatchedUpdates sorts them by class
+static uint16 batchedUpdateSlots[ENTITY_COUNT];
+static uint16 batchedUpdateSorted[ENTITY_COUNT];
+static int32 batchedUpdateCount = 0;
+static int32 batchedClassStart[TYPE_COUNT + 1];
+
+// the draw list spot each queued entity got pushed into before its update ran, keyed by slot
+static uint8 batchedDrawGroup[ENTITY_COUNT];
+static uint16 batchedDrawIndex[ENTITY_COUNT];
+
+#define BATCHED_DRAW_HOLE (0xFFFF)
+
+// the update loops still push batched entities into their draw list right after this, so the spot they get is the one they'd have had if
+// update() ran in place, RunBatchedUpdates only has to move the ones whose update() changes their drawGroup
+static inline void QueueBatchedUpdate(int32 slot)
+{
+    EntityBase *entity = &objectEntityList[slot];
+
+    batchedUpdateSlots[batchedUpdateCount++] = slot;
+    batchedDrawGroup[slot]                   = entity->drawGroup;
+    if (entity->drawGroup < DRAWGROUP_COUNT)
+        batchedDrawIndex[slot] = drawGroups[entity->drawGroup].entityCount;
+}
+
+// punches a hole where a batched entity was pushed, returns false if it was never pushed
+static bool32 RemoveBatchedDrawEntry(int32 slot)
+{
+    uint8 drawGroup = batchedDrawGroup[slot];
+    if (drawGroup >= DRAWGROUP_COUNT)
+        return false;
+
+    DrawList *list = &drawGroups[drawGroup];
+    int32 index    = batchedDrawIndex[slot];
+
+    // an earlier update might've moved it with SwapDrawListEntries
+    if (index >= list->entityCount || list->entries[index] != slot) {
+        for (index = 0; index < list->entityCount; ++index) {
+            if (list->entries[index] == slot)
+                break;
+        }
+
+        if (index == list->entityCount)
+            return false;
+    }
+
+    list->entries[index] = BATCHED_DRAW_HOLE;
+    return true;
+}
+
+static void RunBatchedUpdates()
+{
+    if (!batchedUpdateCount)
+        return;
+
+    PROFILE_SCOPE("BatchedUpdate");
+
+    // counting sort by classID (the same key the type groups use), so each class's batch stays in slot order
+    memset(batchedClassStart, 0, sizeof(batchedClassStart));
+    for (int32 i = 0; i < batchedUpdateCount; ++i) ++batchedClassStart[objectEntityList[batchedUpdateSlots[i]].classID + 1];
+    for (int32 c = 1; c <= TYPE_COUNT; ++c) batchedClassStart[c] += batchedClassStart[c - 1];
+    for (int32 i = 0; i < batchedUpdateCount; ++i)
+        batchedUpdateSorted[batchedClassStart[objectEntityList[batchedUpdateSlots[i]].classID]++] = batchedUpdateSlots[i];
+
+    uint32 holedGroups = 0;
+    for (int32 i = 0; i < batchedUpdateCount; ++i) {
+        sceneInfo.entitySlot = batchedUpdateSorted[i];
+        sceneInfo.entity     = &objectEntityList[sceneInfo.entitySlot];
+
+        // an earlier batch might've destroyed it (or reset it to another class) since it was queued, so it shouldn't be drawn either
+        if (!sceneInfo.entity->classID) {
+            if (RemoveBatchedDrawEntry(sceneInfo.entitySlot))
+                holedGroups |= 1 << batchedDrawGroup[sceneInfo.entitySlot];
+            continue;
+        }
+
+        ObjectClass *classInfo = &objectClassList[stageObjectIDs[sceneInfo.entity->classID]];
+        if (classInfo->update) {
+            PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_UPDATE);
+            classInfo->update();
+        }
+
+        // the update loop pushed it into the draw list it was in beforehand, so move it over if update() changed that
+        uint8 drawGroup = sceneInfo.entity->drawGroup;
+        if (drawGroup != batchedDrawGroup[sceneInfo.entitySlot]) {
+            if (RemoveBatchedDrawEntry(sceneInfo.entitySlot))
+                holedGroups |= 1 << batchedDrawGroup[sceneInfo.entitySlot];
+
+            if (drawGroup < DRAWGROUP_COUNT)
+                drawGroups[drawGroup].entries[drawGroups[drawGroup].entityCount++] = sceneInfo.entitySlot;
+        }
+    }
+
+    for (int32 g = 0; g < DRAWGROUP_COUNT; ++g) {
+        if (!(holedGroups & (1 << g)))
+            continue;
+
+        DrawList *list = &drawGroups[g];
+        int32 count    = 0;
+        for (int32 i = 0; i < list->entityCount; ++i) {
+            if (list->entries[i] != BATCHED_DRAW_HOLE)
+                list->entries[count++] = list->entries[i];
+        }
+        list->entityCount = count;
+    }
+
+    batchedUpdateCount = 0;
+}
+#endif
+
 #if RETRO_REV0U
 #if RETRO_USE_MOD_LOADER
 void RSDK::RegisterObject(Object **staticVars, const char *name, uint32 entityClassSize, uint32 staticClassSize, void (*update)(),
@@ -88,13 +579,49 @@ void RSDK::RegisterObject(Object **staticVars, const char *name, uint32 entityCl
 #endif
 
 #if !RETRO_USE_ORIGINAL_CODE
-        classInfo->name = name;
+        classInfo->name           = name;
+        classInfo->parallelUpdate = NULL;
+        classInfo->batchedUpdate  = false;
 #endif
 
         ++objectClassCount;
     }
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+static ObjectClass *FindRegisteredClass(const char *name)
+{
+    RETRO_HASH_MD5(hash);
+    GEN_HASH_MD5(name, hash);
+
+    // newest first, so if a mod's registered over a class it gets the mod's one
+    for (int32 o = objectClassCount - 1; o >= 0; --o) {
+        if (HASH_MATCH_MD5(hash, objectClassList[o].hash))
+            return &objectClassList[o];
+    }
+
+    return NULL;
+}
+
+void RSDK::RegisterParallelUpdate(const char *name, void (*update)(void *entity))
+{
+    ObjectClass *classInfo = FindRegisteredClass(name);
+    if (classInfo)
+        classInfo->parallelUpdate = update;
+    else
+        PrintLog(PRINT_NORMAL, "ERROR: can't set a parallel update for %s, it hasn't been registered!", name);
+}
+
+void RSDK::RegisterBatchedUpdate(const char *name)
+{
+    ObjectClass *classInfo = FindRegisteredClass(name);
+    if (classInfo)
+        classInfo->batchedUpdate = true;
+    else
+        PrintLog(PRINT_NORMAL, "ERROR: can't batch updates for %s, it hasn't been registered!", name);
+}
+#endif
+
 #if RETRO_REV02 || RETRO_USE_MOD_LOADER
 void RSDK::RegisterStaticVariables(void **staticVars, const char *name, uint32 classSize)
 {
@@ -308,10 +835,15 @@ void RSDK::LoadStaticVariables(uint8 *classPtr, uint32 *hash, int32 readOffset)
 
 void RSDK::InitObjects()
 {
+    PROFILE_SCOPE("InitObjects");
+
     sceneInfo.entitySlot = 0;
     sceneInfo.createSlot = ENTITY_COUNT - 0x100;
     cameraCount          = 0;
 
+    // the scene's entities were written straight into objectEntityList, so this has to happen before any stageLoad gets to use foreach_all
+    RefreshClassEntities();
+
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
 #if RETRO_USE_MOD_LOADER
         currentObjectID = o;
@@ -337,6 +869,11 @@ void RSDK::InitObjects()
         }
     }
 
+    RefreshLiveEntities();
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    ResetEntityHotFields();
+#endif
+
     sceneInfo.state = ENGINESTATE_REGULAR;
 
     if (!cameraCount)
@@ -344,6 +881,8 @@ void RSDK::InitObjects()
 }
 void RSDK::ProcessObjects()
 {
+    PROFILE_SCOPE("ProcessObjects");
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -353,8 +892,10 @@ void RSDK::ProcessObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_NORMAL) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILER_CLASS_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -377,9 +918,13 @@ void RSDK::ProcessObjects()
         }
     }
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    UpdateEntityHotRanges();
+#endif
+
+    for (int32 e = GetNextEntityCandidate(-1); e >= 0; e = GetNextEntityCandidate(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
         if (sceneInfo.entity->classID) {
             switch (sceneInfo.entity->active) {
                 default:
@@ -448,29 +993,47 @@ void RSDK::ProcessObjects()
             }
 
             if (sceneInfo.entity->inRange) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+#if !RETRO_USE_ORIGINAL_CODE
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].parallelUpdate) {
+                    parallelUpdateSlots[parallelUpdateCount++] = e;
+                }
+                else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].batchedUpdate) {
+                    QueueBatchedUpdate(e);
+                }
+                else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#else
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#endif
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_UPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
                     drawGroups[sceneInfo.entity->drawGroup].entries[drawGroups[sceneInfo.entity->drawGroup].entityCount++] = sceneInfo.entitySlot;
             }
         }
         else {
-            sceneInfo.entity->inRange = false;
+            // this slot's been emptied since the last time around, so it can be dropped from the live list
+            sceneInfo.entity->inRange  = false;
+            sceneInfo.entity->onScreen = 0;
+            RemoveLiveEntity(e);
         }
-
-        sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    RunBatchedUpdates();
+    RunParallelUpdates();
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONUPDATE, INT_TO_VOID(ENGINESTATE_REGULAR));
 #endif
 
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) typeGroups[i].entryCount = 0;
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+    for (int32 e = GetNextEntityCandidate(-1); e >= 0; e = GetNextEntityCandidate(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange && sceneInfo.entity->interaction) {
             typeGroups[GROUP_ALL].entries[typeGroups[GROUP_ALL].entryCount++] = e; // All active objects
@@ -480,21 +1043,27 @@ void RSDK::ProcessObjects()
             if (sceneInfo.entity->group >= TYPE_COUNT)
                 typeGroups[sceneInfo.entity->group].entries[typeGroups[sceneInfo.entity->group].entryCount++] = e; // extra groups
         }
-
-        sceneInfo.entitySlot++;
     }
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+#if !RETRO_USE_ORIGINAL_CODE
+    ResetEntityBroadphase();
+#endif
+
+    for (int32 e = GetNextEntityCandidate(-1); e >= 0; e = GetNextEntityCandidate(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange) {
-            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_LATEUPDATE);
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+            }
         }
 
         sceneInfo.entity->onScreen = 0;
-        sceneInfo.entitySlot++;
+#if RETRO_USE_ENTITY_HOT_FIELDS
+        SyncEntityHotFields(e);
+#endif
     }
 
 #if RETRO_USE_MOD_LOADER
@@ -503,6 +1072,11 @@ void RSDK::ProcessObjects()
 }
 void RSDK::ProcessPausedObjects()
 {
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    // anything running while paused can move (or wake up) entities ProcessObjects would've skipped, so start the mirror over afterwards
+    ResetEntityHotFields();
+#endif
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -512,8 +1086,10 @@ void RSDK::ProcessPausedObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_PAUSED) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILER_CLASS_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -521,41 +1097,60 @@ void RSDK::ProcessPausedObjects()
     RunModCallbacks(MODCB_ONSTATICUPDATE, INT_TO_VOID(ENGINESTATE_PAUSED));
 #endif
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+    for (int32 e = GetNextLiveEntity(-1); e >= 0; e = GetNextLiveEntity(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->classID) {
             if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+#if !RETRO_USE_ORIGINAL_CODE
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].parallelUpdate) {
+                    parallelUpdateSlots[parallelUpdateCount++] = e;
+                }
+                else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].batchedUpdate) {
+                    QueueBatchedUpdate(e);
+                }
+                else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#else
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#endif
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_UPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
                     drawGroups[sceneInfo.entity->drawGroup].entries[drawGroups[sceneInfo.entity->drawGroup].entityCount++] = sceneInfo.entitySlot;
             }
         }
         else {
-            sceneInfo.entity->inRange = false;
+            // this slot's been emptied since the last time around, so it can be dropped from the live list
+            sceneInfo.entity->inRange  = false;
+            sceneInfo.entity->onScreen = 0;
+            RemoveLiveEntity(e);
         }
-
-        sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    RunBatchedUpdates();
+    RunParallelUpdates();
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONUPDATE, INT_TO_VOID(ENGINESTATE_PAUSED));
 #endif
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+    for (int32 e = GetNextLiveEntity(-1); e >= 0; e = GetNextLiveEntity(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_LATEUPDATE);
                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+            }
         }
 
         sceneInfo.entity->onScreen = 0;
-        sceneInfo.entitySlot++;
     }
 
 #if RETRO_USE_MOD_LOADER
@@ -564,6 +1159,10 @@ void RSDK::ProcessPausedObjects()
 }
 void RSDK::ProcessFrozenObjects()
 {
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    ResetEntityHotFields();
+#endif
+
     for (int32 i = 0; i < DRAWGROUP_COUNT; ++i) drawGroups[i].entityCount = 0;
 
     for (int32 o = 0; o < sceneInfo.classCount; ++o) {
@@ -573,8 +1172,10 @@ void RSDK::ProcessFrozenObjects()
 
         ObjectClass *classInfo = &objectClassList[stageObjectIDs[o]];
         if ((*classInfo->staticVars)->active == ACTIVE_ALWAYS || (*classInfo->staticVars)->active == ACTIVE_PAUSED) {
-            if (classInfo->staticUpdate)
+            if (classInfo->staticUpdate) {
+                PROFILE_CLASS(stageObjectIDs[o], PROFILER_CLASS_STATICUPDATE);
                 classInfo->staticUpdate();
+            }
         }
     }
 
@@ -597,9 +1198,9 @@ void RSDK::ProcessFrozenObjects()
         }
     }
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+    for (int32 e = GetNextLiveEntity(-1); e >= 0; e = GetNextLiveEntity(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->classID) {
             switch (sceneInfo.entity->active) {
@@ -670,8 +1271,20 @@ void RSDK::ProcessFrozenObjects()
 
             if (sceneInfo.entity->inRange) {
                 if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                    if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update)
+#if !RETRO_USE_ORIGINAL_CODE
+                    if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].parallelUpdate) {
+                        parallelUpdateSlots[parallelUpdateCount++] = e;
+                    }
+                    else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].batchedUpdate) {
+                        QueueBatchedUpdate(e);
+                    }
+                    else if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#else
+                    if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update) {
+#endif
+                        PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_UPDATE);
                         objectClassList[stageObjectIDs[sceneInfo.entity->classID]].update();
+                    }
                 }
 
                 if (sceneInfo.entity->drawGroup < DRAWGROUP_COUNT)
@@ -679,26 +1292,34 @@ void RSDK::ProcessFrozenObjects()
             }
         }
         else {
-            sceneInfo.entity->inRange = false;
+            // this slot's been emptied since the last time around, so it can be dropped from the live list
+            sceneInfo.entity->inRange  = false;
+            sceneInfo.entity->onScreen = 0;
+            RemoveLiveEntity(e);
         }
-
-        sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    RunBatchedUpdates();
+    RunParallelUpdates();
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONUPDATE, INT_TO_VOID(ENGINESTATE_FROZEN));
 #endif
 
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) typeGroups[i].entryCount = 0;
 
-    sceneInfo.entitySlot = 0;
-    for (int32 e = 0; e < ENTITY_COUNT; ++e) {
-        sceneInfo.entity = &objectEntityList[e];
+    for (int32 e = GetNextLiveEntity(-1); e >= 0; e = GetNextLiveEntity(e)) {
+        sceneInfo.entitySlot = e;
+        sceneInfo.entity     = &objectEntityList[e];
 
         if (sceneInfo.entity->inRange) {
             if (sceneInfo.entity->active == ACTIVE_ALWAYS || sceneInfo.entity->active == ACTIVE_PAUSED) {
-                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate)
+                if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate) {
+                    PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_LATEUPDATE);
                     objectClassList[stageObjectIDs[sceneInfo.entity->classID]].lateUpdate();
+                }
             }
 
             if (sceneInfo.entity->interaction) {
@@ -712,19 +1333,27 @@ void RSDK::ProcessFrozenObjects()
         }
 
         sceneInfo.entity->onScreen = 0;
-        sceneInfo.entitySlot++;
     }
 
+#if !RETRO_USE_ORIGINAL_CODE
+    ResetEntityBroadphase();
+#endif
+
 #if RETRO_USE_MOD_LOADER
     RunModCallbacks(MODCB_ONLATEUPDATE, INT_TO_VOID(ENGINESTATE_FROZEN));
 #endif
 }
 void RSDK::ProcessObjectDrawLists()
 {
+    PROFILE_SCOPE("ProcessDrawLists");
+
     if (sceneInfo.state != ENGINESTATE_LOAD && sceneInfo.state != (ENGINESTATE_LOAD | ENGINESTATE_STEPOVER)) {
         for (int32 s = 0; s < videoSettings.screenCount; ++s) {
             currentScreen             = &screens[s];
             sceneInfo.currentScreenID = s;
+#if RETRO_USE_DRAW_COMMANDS
+            BeginDrawCommands(s);
+#endif
 
             for (int32 l = 0; l < DRAWGROUP_COUNT; ++l) drawGroups[l].layerCount = 0;
 
@@ -761,8 +1390,10 @@ void RSDK::ProcessObjectDrawLists()
                         validDraw            = false;
                         sceneInfo.entity     = &objectEntityList[list->entries[i]];
                         if (sceneInfo.entity->visible) {
-                            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw)
+                            if (objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw) {
+                                PROFILE_CLASS(stageObjectIDs[sceneInfo.entity->classID], PROFILER_CLASS_DRAW);
                                 objectClassList[stageObjectIDs[sceneInfo.entity->classID]].draw();
+                            }
 
 #if RETRO_VER_EGS || RETRO_USE_DUMMY_ACHIEVEMENTS
                             if (i == list->entityCount - 1)
@@ -784,6 +1415,25 @@ void RSDK::ProcessObjectDrawLists()
                         else
                             ProcessParallax(layer);
 
+#if RETRO_USE_LAYER_CACHE
+                        if (UpdateLayerCache(list->layerDrawList[i], s)) {
+#if RETRO_USE_DRAW_COMMANDS
+                            if (drawRecording)
+                                RecordDrawLayerCache(list->layerDrawList[i], s);
+                            else
+#endif
+                                DrawLayerCache(list->layerDrawList[i], s);
+                            continue;
+                        }
+#endif
+
+#if RETRO_USE_DRAW_COMMANDS
+                        if (drawRecording) {
+                            RecordDrawLayer(list->layerDrawList[i]);
+                            continue;
+                        }
+#endif
+
                         switch (layer->type) {
                             case LAYER_HSCROLL: DrawLayerHScroll(layer); break;
                             case LAYER_VSCROLL: DrawLayerVScroll(layer); break;
@@ -793,6 +1443,11 @@ void RSDK::ProcessObjectDrawLists()
                         }
                     }
 
+#if RETRO_USE_DRAW_COMMANDS
+                    // draw whatever this draw group recorded before anyone else gets to look at the framebuffer
+                    FlushDrawGroup();
+#endif
+
 #if RETRO_USE_MOD_LOADER
                     RunModCallbacks(MODCB_ONDRAW, INT_TO_VOID(l));
 #endif
@@ -995,11 +1650,25 @@ void RSDK::ProcessObjectDrawLists()
                 }
             }
 
+#if RETRO_USE_PROFILER
+            if (s == 0)
+                DrawProfilerOverlay();
+#endif
+
+#endif
+
+#if RETRO_USE_DRAW_COMMANDS
+            EndDrawCommands();
 #endif
 
             currentScreen++;
             sceneInfo.currentScreenID++;
         }
+
+#if RETRO_USE_DRAW_COMMANDS
+        // split screen views might still be getting drawn
+        SyncDrawCommands();
+#endif
     }
 }
 
@@ -1057,6 +1726,15 @@ void RSDK::ResetEntity(Entity *entity, uint16 classID, void *data)
         }
 
         entity->classID = classID;
+
+        uint32 slot = (uint32)((EntityBase *)entity - objectEntityList);
+        if (slot < ENTITY_COUNT) {
+            if (classID)
+                AddLiveEntity(slot);
+            else
+                RemoveLiveEntity(slot);
+            AddClassEntity(slot, classID);
+        }
     }
 }
 
@@ -1088,6 +1766,12 @@ void RSDK::ResetEntitySlot(uint16 slot, uint16 classID, void *data)
     else {
         entity->classID = classID;
     }
+
+    if (classID)
+        AddLiveEntity(slot);
+    else
+        RemoveLiveEntity(slot);
+    AddClassEntity(slot, classID);
 }
 
 Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
@@ -1146,6 +1830,10 @@ Entity *RSDK::CreateEntity(uint16 classID, void *data, int32 x, int32 y)
         entity->visible = true;
     }
 
+    if (classID)
+        AddLiveEntity(sceneInfo.createSlot);
+    AddClassEntity(sceneInfo.createSlot, classID);
+
     return entity;
 }
 
@@ -1193,6 +1881,38 @@ bool32 RSDK::GetAllEntities(uint16 classID, Entity **entity)
         foreachStackPtr->id = 0;
     }
 
+#if RETRO_USE_CLASS_ENTITY_LIST
+    if (classID) {
+        // foreachStackPtr->id is still the slot, it just skips straight to the next one that might have the right class
+        uint64 *slots = classEntitySlots[classID];
+        int32 word    = foreachStackPtr->id >> 6;
+        uint64 bits   = word < CLASSENTITY_WORD_COUNT ? slots[word] & (~(uint64)0 << (foreachStackPtr->id & 63)) : 0;
+
+        while (word < CLASSENTITY_WORD_COUNT) {
+            while (bits) {
+                foreachStackPtr->id = (word << 6) + GetLowestEntityBit(bits);
+                bits &= bits - 1;
+
+                Entity *nextEntity = &objectEntityList[foreachStackPtr->id];
+                if (nextEntity->classID == classID) {
+                    *entity = nextEntity;
+                    return true;
+                }
+
+                // it's been reset to something else since it was added
+                slots[word] &= ~((uint64)1 << (foreachStackPtr->id & 63));
+            }
+
+            if (++word < CLASSENTITY_WORD_COUNT)
+                bits = slots[word];
+        }
+
+        foreachStackPtr--;
+
+        return false;
+    }
+#endif
+
     for (; foreachStackPtr->id < ENTITY_COUNT; ++foreachStackPtr->id) {
         Entity *nextEntity = &objectEntityList[foreachStackPtr->id];
         if (nextEntity->classID == classID) {
@@ -1206,6 +1926,67 @@ bool32 RSDK::GetAllEntities(uint16 classID, Entity **entity)
     return false;
 }
 
+#if !RETRO_USE_ORIGINAL_CODE
+int32 RSDK::GetEntitiesInRect(uint16 group, int32 left, int32 top, int32 right, int32 bottom, Entity **entities, int32 maxCount)
+{
+    if (group >= TYPEGROUP_COUNT || !entities || maxCount <= 0)
+        return 0;
+
+    uint64 slots[BROADPHASE_WORD_COUNT];
+    GetBroadphaseCandidates(left, top, right, bottom, slots);
+
+    // walking the bits gives back slot order, same as foreach_active would
+    int32 count = 0;
+    for (int32 w = 0; w < BROADPHASE_WORD_COUNT; ++w) {
+        for (uint64 bits = slots[w]; bits; bits &= bits - 1) {
+            EntityBase *entity = &objectEntityList[(w << 6) + GetLowestEntityBit(bits)];
+
+            if (CheckBroadphaseGroup(entity, group) && entity->position.x >= left && entity->position.x <= right && entity->position.y >= top
+                && entity->position.y <= bottom) {
+                entities[count++] = entity;
+                if (count >= maxCount)
+                    return count;
+            }
+        }
+    }
+
+    return count;
+}
+int32 RSDK::GetEntitiesNear(Entity *entity, int32 radius, uint16 group, Entity **entities, int32 maxCount)
+{
+    if (!entity || radius < 0 || group >= TYPEGROUP_COUNT || !entities || maxCount <= 0)
+        return 0;
+
+    // 64-bit since a position near the edge of the int32 range plus the radius won't fit back in one
+    int64 x = entity->position.x;
+    int64 y = entity->position.y;
+
+    uint64 slots[BROADPHASE_WORD_COUNT];
+    GetBroadphaseCandidates(x - radius, y - radius, x + radius, y + radius, slots);
+
+    int64 radiusSq = (int64)FROM_FIXED(radius) * FROM_FIXED(radius);
+
+    int32 count = 0;
+    for (int32 w = 0; w < BROADPHASE_WORD_COUNT; ++w) {
+        for (uint64 bits = slots[w]; bits; bits &= bits - 1) {
+            EntityBase *other = &objectEntityList[(w << 6) + GetLowestEntityBit(bits)];
+            if (other == entity || !CheckBroadphaseGroup(other, group))
+                continue;
+
+            int64 dx = FROM_FIXED(other->position.x - x);
+            int64 dy = FROM_FIXED(other->position.y - y);
+            if (dx * dx + dy * dy <= radiusSq) {
+                entities[count++] = other;
+                if (count >= maxCount)
+                    return count;
+            }
+        }
+    }
+
+    return count;
+}
+#endif
+
 bool32 RSDK::CheckOnScreen(Entity *entity, Vector2 *range)
 {
     if (!entity)
@@ -182,6 +182,11 @@ struct ObjectClass {
 
 #if !RETRO_USE_ORIGINAL_CODE
     const char *name; // for debugging purposes
+
+    // set with RegisterParallelUpdate, used instead of update for every entity of this class
+    void (*parallelUpdate)(void *entity);
+    // set with RegisterBatchedUpdate, entities of this class get updated together once the slot order ones are done
+    bool32 batchedUpdate;
 #endif
 };
 
@@ -213,6 +218,58 @@ extern int32 stageObjectIDs[OBJECT_COUNT];
 
 extern EntityBase objectEntityList[ENTITY_COUNT];
 
+#if RETRO_USE_LIVE_ENTITY_LIST
+// one bit per slot that might have an entity in it. slots get added by ResetEntity/ResetEntitySlot/CreateEntity/CopyEntity (& a full rescan once
+// a scene's objects are set up), but only get removed once the update loop sees their classID is 0, so game code clearing it directly is fine.
+// anything that brings a slot to life has to go through the engine though
+#define LIVEENTITY_WORD_COUNT ((ENTITY_COUNT + 63) / 64)
+extern uint64 liveEntitySlots[LIVEENTITY_WORD_COUNT];
+#if RETRO_USE_ENTITY_HOT_FIELDS
+// slots with up to date hot fields & the ones ProcessObjects is skipping this frame (see Object.cpp), a reset slot's mirror can't be trusted
+extern uint64 entityHotSlots[LIVEENTITY_WORD_COUNT];
+extern uint64 entityHotSkip[LIVEENTITY_WORD_COUNT];
+#endif
+
+inline void AddLiveEntity(int32 slot)
+{
+    liveEntitySlots[slot >> 6] |= (uint64)1 << (slot & 63);
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    entityHotSlots[slot >> 6] &= ~((uint64)1 << (slot & 63));
+    entityHotSkip[slot >> 6] &= ~((uint64)1 << (slot & 63));
+#endif
+}
+inline void RemoveLiveEntity(int32 slot)
+{
+    liveEntitySlots[slot >> 6] &= ~((uint64)1 << (slot & 63));
+#if RETRO_USE_ENTITY_HOT_FIELDS
+    entityHotSlots[slot >> 6] &= ~((uint64)1 << (slot & 63));
+    entityHotSkip[slot >> 6] &= ~((uint64)1 << (slot & 63));
+#endif
+}
+void RefreshLiveEntities();
+#else
+inline void AddLiveEntity(int32 slot) {}
+inline void RemoveLiveEntity(int32 slot) {}
+inline void RefreshLiveEntities() {}
+#endif
+
+#if RETRO_USE_CLASS_ENTITY_LIST
+// one bit per slot that might have an entity of each class in it (class 0 isn't tracked, GetAllEntities checks every slot for that one)
+// bits are set by the same things that add live entities & only cleared once GetAllEntities finds the slot's classID has changed
+#define CLASSENTITY_WORD_COUNT ((ENTITY_COUNT + 63) / 64)
+extern uint64 classEntitySlots[OBJECT_COUNT][CLASSENTITY_WORD_COUNT];
+
+inline void AddClassEntity(int32 slot, uint16 classID)
+{
+    if (classID && classID < OBJECT_COUNT)
+        classEntitySlots[classID][slot >> 6] |= (uint64)1 << (slot & 63);
+}
+void RefreshClassEntities();
+#else
+inline void AddClassEntity(int32 slot, uint16 classID) {}
+inline void RefreshClassEntities() {}
+#endif
+
 extern EditableVarInfo *editableVarList;
 extern int32 editableVarCount;
 
@@ -221,7 +278,7 @@ extern ForeachStackInfo *foreachStackPtr;
 
 extern TypeGroupList typeGroups[TYPEGROUP_COUNT];
 
-extern bool32 validDraw;
+extern RETRO_RENDER_TLS bool32 validDraw;
 
 #if RETRO_REV0U
 void RegisterObject(Object **staticVars, const char *name, uint32 entityClassSize, uint32 staticClassSize, void (*update)(), void (*lateUpdate)(),
@@ -251,6 +308,21 @@ void RegisterObject_STD(Object **staticVars, const char *name, uint32 entityClas
 void RegisterStaticVariables(void **varClass, const char *name, uint32 classSize);
 #endif
 
+#if !RETRO_USE_ORIGINAL_CODE
+// marks an already registered class as parallel-safe, so instead of calling update() in slot order, every in range entity of it gets passed to
+// "update" as part of a batch run across the job threads once all the other entities are updated. sceneInfo.entity is shared by every thread
+// so it's left alone, "entity" is the one to update. these can only touch their own entity & things like ProcessAnimation/math, anything that
+// changes shared state (creating/destroying entities, collision, sfx, Rand, etc) or relies on running in order has to stay in update()
+// NOTE: drawGroup is read before the batch runs, so changing it in here takes effect next frame
+void RegisterParallelUpdate(const char *name, void (*update)(void *entity));
+// marks an already registered class as not caring what order it's updated in relative to other classes, so rather than being updated in slot
+// order its in range entities get queued up & updated back to back (still in slot order) after every other entity, one class at a time
+// this keeps the class's update() & static vars in cache instead of jumping between dozens of classes every slot. update() is still called
+// as usual on the main thread, so anything goes in there as long as it doesn't rely on entities of other classes updating first (or after)
+// NOTE: same as parallel updates, drawGroup is read before the batch runs
+void RegisterBatchedUpdate(const char *name);
+#endif
+
 void LoadStaticVariables(uint8 *classPtr, uint32 *hash, int32 readOffset);
 
 #define RSDK_EDITABLE_VAR(object, type, var) RSDK.SetEditableVar(type, #var, (uint8)object->classID, offsetof(Entity##object, var))
@@ -305,6 +377,12 @@ inline void CopyEntity(void *destEntity, void *srcEntity, bool32 clearSrcEntity)
 
         if (clearSrcEntity)
             memset(srcEntity, 0, sizeof(EntityBase));
+
+        uint32 slot = (uint32)((EntityBase *)destEntity - objectEntityList);
+        if (slot < ENTITY_COUNT && ((EntityBase *)destEntity)->classID) {
+            AddLiveEntity(slot);
+            AddClassEntity(slot, ((EntityBase *)destEntity)->classID);
+        }
     }
 }
 
@@ -313,6 +391,19 @@ bool32 GetAllEntities(uint16 classID, Entity **entity);
 
 inline void BreakForeachLoop() { --foreachStackPtr; }
 
+#if !RETRO_USE_ORIGINAL_CODE
+// broadphase queries for finding collision partners without walking a whole type group, only entities that made it into typeGroups this frame
+// (in range & interacting) can be returned. both fill "entities" with up to "maxCount" matches in slot order (the same order foreach_active goes
+// in) & return how many there were. positions are checked as they are now, but the broadphase itself is only built by the first query after
+// typeGroups are rebuilt, so anything that's moved more than 64px since then can be missed until the next frame.
+// "group" can be GROUP_ALL (anything that isn't a blank object), a classID, or one of the extra groups past TYPE_COUNT (matched on entity->group)
+int32 GetEntitiesInRect(uint16 group, int32 left, int32 top, int32 right, int32 bottom, Entity **entities, int32 maxCount);
+// everything in "group" within "radius" of "entity"'s position, leaving out "entity" itself
+int32 GetEntitiesNear(Entity *entity, int32 radius, uint16 group, Entity **entities, int32 maxCount);
+// has the broadphase rebuilt from typeGroups the next time it's queried, needs calling whenever they change
+void ResetEntityBroadphase();
+#endif
+
 // CheckPosOnScreen but if range is NULL it'll use entity->updateRange
 bool32 CheckOnScreen(Entity *entity, Vector2 *range);
 // Checks if a position is on screen & within range
@@ -1,5 +1,9 @@
 #include "RSDK/Core/RetroEngine.hpp"
 
+#if RETRO_USE_TILE_CACHE
+#include <atomic>
+#endif
+
 using namespace RSDK;
 
 #if RETRO_REV0U
@@ -7,12 +11,125 @@ using namespace RSDK;
 #endif
 
 uint8 RSDK::tilesetPixels[TILESET_SIZE * 4];
+uint16 RSDK::tileEmptyRows[TILE_COUNT * 4];
+uint16 RSDK::tileOpaqueRows[TILE_COUNT * 4];
+
+#if RETRO_USE_TILE_CACHE
+#define TILECOLORS_BUILDING (0xFFFFFFFF)
+
+// tiles with their colours already looked up, each bank's copy of a tile only gets built once it's drawn using that bank
+// (a bank's whole cache is 2MB, so it isn't allocated until the first of its tiles gets cached)
+static std::atomic<uint16 *> tileColorCache[PALETTE_BANK_COUNT];
+// the paletteVersion each tile was built with (0 if it hasn't been), these get checked from the render threads so they're atomic
+static std::atomic<uint32> tileColorVersion[PALETTE_BANK_COUNT][TILE_COUNT * 4];
+static std::atomic<uint8> tileColorDisabledBanks(0);
+
+static uint16 *GetTileColors(uint8 bankID, uint16 tile)
+{
+    std::atomic<uint32> &version = tileColorVersion[bankID][tile];
+    uint32 currentVersion        = paletteVersion[bankID].load(std::memory_order_relaxed);
+
+    // tiles only ever get a version once the bank's cache exists, so it's safe to use here
+    uint32 builtVersion = version.load(std::memory_order_acquire);
+    if (builtVersion == currentVersion)
+        return &tileColorCache[bankID].load(std::memory_order_relaxed)[tile * TILE_DATASIZE];
+
+    // if another thread's already building it just do the lookups as normal this time round
+    if (builtVersion == TILECOLORS_BUILDING || (tileColorDisabledBanks.load(std::memory_order_relaxed) >> bankID & 1)
+        || !version.compare_exchange_strong(builtVersion, TILECOLORS_BUILDING, std::memory_order_acquire))
+        return NULL;
+
+    uint16 *bankColors = tileColorCache[bankID].load(std::memory_order_acquire);
+    if (!bankColors) {
+        uint16 *newColors = (uint16 *)malloc(TILESET_SIZE * 4 * sizeof(uint16));
+        if (newColors && !tileColorCache[bankID].compare_exchange_strong(bankColors, newColors, std::memory_order_acq_rel))
+            free(newColors); // another thread got there first, bankColors is theirs now
+        else
+            bankColors = newColors;
+
+        if (!bankColors) {
+            version.store(builtVersion, std::memory_order_release);
+            return NULL;
+        }
+    }
+
+    uint16 *colors        = &bankColors[tile * TILE_DATASIZE];
+    uint16 *activePalette = fullPalette[bankID];
+    uint8 *pixels         = &tilesetPixels[tile * TILE_DATASIZE];
+    for (int32 p = 0; p < TILE_DATASIZE; ++p) colors[p] = activePalette[pixels[p]];
+
+    version.store(currentVersion, std::memory_order_release);
+    return colors;
+}
+
+void RSDK::DisableTileColorCache(uint8 bankID)
+{
+    if (bankID < PALETTE_BANK_COUNT)
+        tileColorDisabledBanks.fetch_or(1 << bankID);
+}
 
-ScanlineInfo *RSDK::scanlines = NULL;
+void RSDK::ReleaseTileColorCache()
+{
+    for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) {
+        for (int32 t = 0; t < TILE_COUNT * 4; ++t) tileColorVersion[b][t].store(0, std::memory_order_relaxed);
+
+        free(tileColorCache[b].exchange(NULL));
+    }
+}
+#endif
+
+#if RETRO_USE_LAYER_CACHE
+#define LAYERCACHE_TILE_UNUSED (0x7FFFFFFF)
+
+struct LayerCacheTile {
+    // the (unwrapped) tile position this holds, along with the layout entry & tile version it was drawn from
+    int32 x;
+    int32 y;
+    uint16 tile;
+    uint32 version;
+    uint16 rowMasks[TILE_SIZE]; // a bit for every solid pixel on the row
+    uint16 pixels[TILE_DATASIZE];
+};
+
+struct LayerCache {
+    LayerCacheTile *tiles; // tileCountX * tileCountY, wraps around in both directions as the layer scrolls
+    int32 tileCountX;
+    int32 tileCountY;
+    // where the screen's top left is on the layer, unwrapped so cached tiles stay put when the layer wraps around
+    int32 viewX;
+    int32 viewY;
+    // same as above but wrapped to the layer, used to work out how far it's moved since the last update
+    int32 layerX;
+    int32 layerY;
+    uint16 xsize;
+    uint16 ysize;
+    uint8 paletteBank;
+    uint32 paletteVersion;
+};
+
+static LayerCache layerCaches[SCREEN_COUNT][LAYER_COUNT];
+// bumped by UpdateTileRowInfo, so cached tiles can tell when their pixels have been changed
+static uint32 tileVersion[TILE_COUNT * 4];
+
+static inline int32 WrapLayerPos(int32 pos, int32 size)
+{
+    pos %= size;
+    return pos < 0 ? pos + size : pos;
+}
+#endif
+
+RETRO_RENDER_TLS ScanlineInfo *RSDK::scanlines = NULL;
 TileLayer RSDK::tileLayers[LAYER_COUNT];
 CollisionMask RSDK::collisionMasks[CPATH_COUNT][TILE_COUNT * 4];
 TileInfo RSDK::tileInfo[CPATH_COUNT][TILE_COUNT * 4];
 
+#if RETRO_USE_SOLIDITY_BITMAPS
+TileLayerSolidity RSDK::layerSolidity[LAYER_COUNT];
+
+uint8 RSDK::tileHeightFields[CPATH_COUNT][4][TILE_COUNT * 4][TILE_SIZE];
+bool32 RSDK::tileHeightFieldsShared = false;
+#endif
+
 #if RETRO_REV02
 bool32 RSDK::forceHardReset = false;
 #endif
@@ -23,6 +140,8 @@ SceneInfo RSDK::sceneInfo;
 
 void RSDK::LoadSceneFolder()
 {
+    PROFILE_SCOPE("LoadSceneFolder");
+
 #if RETRO_PLATFORM == RETRO_ANDROID
     ShowLoadingIcon();
 #endif
@@ -47,6 +166,9 @@ void RSDK::LoadSceneFolder()
     for (int32 i = 0; i < TYPEGROUP_COUNT; ++i) {
         typeGroups[i].entryCount = 0;
     }
+#if !RETRO_USE_ORIGINAL_CODE
+    ResetEntityBroadphase();
+#endif
 
 #if RETRO_REV02
     // Unload debug values
@@ -56,10 +178,17 @@ void RSDK::LoadSceneFolder()
     tintLookupTable = NULL;
 #endif
 
+#if RETRO_USE_PROFILER
+    ResetProfilerClassStats();
+#endif
+
     // Unload TileLayers
     for (int32 l = 0; l < LAYER_COUNT; ++l) {
         MEM_ZERO(tileLayers[l]);
         for (int32 c = 0; c < CAMERA_COUNT; ++c) tileLayers[l].drawGroup[c] = -1;
+#if RETRO_USE_SOLIDITY_BITMAPS
+        MEM_ZERO(layerSolidity[l]);
+#endif
     }
 
     SceneListInfo *list = &sceneInfo.listCategory[sceneInfo.activeCategory];
@@ -282,6 +411,8 @@ void RSDK::LoadSceneFolder()
 }
 void RSDK::LoadSceneAssets()
 {
+    PROFILE_SCOPE("LoadSceneAssets");
+
 #if RETRO_PLATFORM == RETRO_ANDROID
     ShowLoadingIcon();
 #endif
@@ -312,6 +443,8 @@ void RSDK::LoadSceneAssets()
                 for (int32 c = 0; c < 0x10; ++c) fullPalette[b][(r << 4) + c] = stagePalette[b][(r << 4) + c];
             }
         }
+
+        ++paletteVersion[b];
     }
 
     FileInfo info;
@@ -387,6 +520,9 @@ void RSDK::LoadSceneAssets()
                 val   = 1 << shift2++;
             } while (val < layer->xsize);
             layer->widthShift = shift;
+#if RETRO_USE_CHUNKED_LAYOUT
+            layer->widthShift = MAX(layer->widthShift, LAYOUT_CHUNK_SHIFT);
+#endif
 
             layer->ysize = ReadInt16(&info);
             shift        = 1;
@@ -397,6 +533,9 @@ void RSDK::LoadSceneAssets()
                 val   = 1 << shift2++;
             } while (val < layer->ysize);
             layer->heightShift = shift;
+#if RETRO_USE_CHUNKED_LAYOUT
+            layer->heightShift = MAX(layer->heightShift, LAYOUT_CHUNK_SHIFT);
+#endif
 
             layer->parallaxFactor = ReadInt16(&info);
             layer->scrollSpeed    = ReadInt16(&info) << 8;
@@ -439,7 +578,7 @@ void RSDK::LoadSceneAssets()
             int32 id = 0;
             for (int32 y = 0; y < layer->ysize; ++y) {
                 for (int32 x = 0; x < layer->xsize; ++x) {
-                    layer->layout[x + (y << layer->widthShift)] = (tileLayout[id + 1] << 8) + tileLayout[id + 0];
+                    layer->layout[GetLayoutIndex(layer, x, y)] = (tileLayout[id + 1] << 8) + tileLayout[id + 0];
                     id += 2;
                 }
             }
@@ -448,6 +587,10 @@ void RSDK::LoadSceneAssets()
             RemoveStorageEntry((void **)&tileLayout);
 #endif
             tileLayout = NULL;
+
+#if RETRO_USE_SOLIDITY_BITMAPS
+            RefreshLayerSolidity(l);
+#endif
         }
 
         // Objects
@@ -954,6 +1097,10 @@ void RSDK::LoadTileConfig(char *filepath)
         buffer = NULL;
 #endif
         CloseFile(&info);
+
+#if RETRO_USE_SOLIDITY_BITMAPS
+        RefreshTileHeightFields();
+#endif
     }
 }
 void RSDK::LoadStageGIF(char *filepath)
@@ -975,6 +1122,7 @@ void RSDK::LoadStageGIF(char *filepath)
                 }
             }
         }
+        ++paletteVersion[0];
 
         // Flip X
         uint8 *srcPixels = tilesetPixels;
@@ -1011,6 +1159,8 @@ void RSDK::LoadStageGIF(char *filepath)
             dstPixels += (TILE_SIZE * 2);
         }
 
+        UpdateTileRowInfo(0, TILE_COUNT);
+
 #if RETRO_USE_ORIGINAL_CODE
         tileset.palette = NULL;
         tileset.decoder = NULL;
@@ -1019,6 +1169,44 @@ void RSDK::LoadStageGIF(char *filepath)
     }
 }
 
+void RSDK::UpdateTileRowInfo(uint16 tile, uint16 count)
+{
+    if (tile >= TILE_COUNT)
+        return;
+
+    if (tile + count > TILE_COUNT)
+        count = TILE_COUNT - tile;
+
+    for (int32 f = FLIP_NONE; f <= FLIP_XY; ++f) {
+        for (int32 t = tile; t < tile + count; ++t) {
+            int32 tileID  = t + (f * TILE_COUNT);
+            uint8 *pixels = &tilesetPixels[tileID * TILE_DATASIZE];
+
+            uint16 emptyRows  = 0;
+            uint16 opaqueRows = 0;
+            for (int32 y = 0; y < TILE_SIZE; ++y) {
+                int32 opaqueCount = 0;
+                for (int32 x = 0; x < TILE_SIZE; ++x) opaqueCount += *pixels++ != 0;
+
+                if (!opaqueCount)
+                    emptyRows |= 1 << y;
+                else if (opaqueCount == TILE_SIZE)
+                    opaqueRows |= 1 << y;
+            }
+
+            tileEmptyRows[tileID]  = emptyRows;
+            tileOpaqueRows[tileID] = opaqueRows;
+
+#if RETRO_USE_TILE_CACHE
+            for (int32 b = 0; b < PALETTE_BANK_COUNT; ++b) tileColorVersion[b][tileID].store(0, std::memory_order_relaxed);
+#endif
+#if RETRO_USE_LAYER_CACHE
+            ++tileVersion[tileID];
+#endif
+        }
+    }
+}
+
 void RSDK::ProcessParallaxAutoScroll()
 {
     for (int32 l = 0; l < LAYER_COUNT; ++l) {
@@ -1263,6 +1451,7 @@ void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, ui
                          int32 countY)
 {
     if (dstLayerID < LAYER_COUNT && srcLayerID < LAYER_COUNT) {
+        SyncDrawCommands();
         TileLayer *dstLayer = &tileLayers[dstLayerID];
         TileLayer *srcLayer = &tileLayers[srcLayerID];
 
@@ -1282,8 +1471,11 @@ void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, ui
 
                 for (int32 y = 0; y < countY; ++y) {
                     for (int32 x = 0; x < countX; ++x) {
-                        uint16 tile = srcLayer->layout[(x + srcStartX) + ((y + srcStartY) << srcLayer->widthShift)];
-                        dstLayer->layout[(x + dstStartX) + ((y + dstStartY) << dstLayer->widthShift)] = tile;
+                        uint16 tile = srcLayer->layout[GetLayoutIndex(srcLayer, x + srcStartX, y + srcStartY)];
+                        dstLayer->layout[GetLayoutIndex(dstLayer, x + dstStartX, y + dstStartY)] = tile;
+#if RETRO_USE_SOLIDITY_BITMAPS
+                        UpdateTileSolidity(dstLayerID, x + dstStartX, y + dstStartY, tile);
+#endif
                     }
                 }
             }
@@ -1291,8 +1483,62 @@ void RSDK::CopyTileLayer(uint16 dstLayerID, int32 dstStartX, int32 dstStartY, ui
     }
 }
 
+#if RETRO_USE_SOLIDITY_BITMAPS
+void RSDK::RefreshLayerSolidity(uint16 layerID)
+{
+    if (layerID >= LAYER_COUNT)
+        return;
+
+    TileLayer *layer            = &tileLayers[layerID];
+    TileLayerSolidity *solidity = &layerSolidity[layerID];
+
+    int32 blockCountX = (layer->xsize + SOLIDITY_BLOCK_MASK) >> SOLIDITY_BLOCK_SHIFT;
+    int32 blockCountY = (layer->ysize + SOLIDITY_BLOCK_MASK) >> SOLIDITY_BLOCK_SHIFT;
+    if (!layer->layout || !blockCountX || !blockCountY) {
+        solidity->blocks = NULL;
+        return;
+    }
+
+    uint32 size = sizeof(uint64) * SOLIDITY_FLAG_COUNT * blockCountX * blockCountY;
+    if (!solidity->blocks || solidity->blockCountX != blockCountX || solidity->blockCountY != blockCountY) {
+        solidity->blocks = NULL;
+        AllocateStorage((void **)&solidity->blocks, size, DATASET_STG, false);
+        if (!solidity->blocks)
+            return;
+    }
+
+    memset(solidity->blocks, 0, size);
+    solidity->layout      = layer->layout;
+    solidity->blockCountX = blockCountX;
+    solidity->blockCountY = blockCountY;
+
+    for (int32 y = 0; y < layer->ysize; ++y) {
+        for (int32 x = 0; x < layer->xsize; ++x) UpdateTileSolidity(layerID, x, y, layer->layout[GetLayoutIndex(layer, x, y)]);
+    }
+}
+
+void RSDK::UpdateTileHeightFields(uint8 cPlane, uint16 tile)
+{
+    CollisionMask *mask = &collisionMasks[cPlane][tile];
+
+    memcpy(tileHeightFields[cPlane][CMODE_FLOOR][tile], mask->floorMasks, TILE_SIZE);
+    memcpy(tileHeightFields[cPlane][CMODE_LWALL][tile], mask->lWallMasks, TILE_SIZE);
+    memcpy(tileHeightFields[cPlane][CMODE_ROOF][tile], mask->roofMasks, TILE_SIZE);
+    memcpy(tileHeightFields[cPlane][CMODE_RWALL][tile], mask->rWallMasks, TILE_SIZE);
+}
+
+void RSDK::RefreshTileHeightFields()
+{
+    for (int32 p = 0; p < CPATH_COUNT; ++p) {
+        for (int32 t = 0; t < TILE_COUNT * 4; ++t) UpdateTileHeightFields(p, t);
+    }
+}
+#endif
+
 void RSDK::DrawLayerHScroll(TileLayer *layer)
 {
+    PROFILE_SCOPE("DrawLayerHScroll");
+
     if (!layer->xsize || !layer->ysize)
         return;
 
@@ -1305,7 +1551,8 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
         int32 x               = scanline->position.x;
         int32 y               = scanline->position.y;
         int32 tileX           = FROM_FIXED(x);
-        uint16 *activePalette = fullPalette[*lineBuffer++];
+        uint8 paletteBank     = *lineBuffer++;
+        uint16 *activePalette = fullPalette[paletteBank];
 
         if (tileX >= TILE_SIZE * layer->xsize)
             x = TO_FIXED(tileX - TILE_SIZE * layer->xsize);
@@ -1315,15 +1562,29 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
         int32 tileRemain = TILE_SIZE - (FROM_FIXED(x) & 0xF);
         int32 sheetX     = FROM_FIXED(x) & 0xF;
         int32 sheetY     = TILE_SIZE * (FROM_FIXED(y) & 0xF);
+        uint16 rowMask   = 1 << (FROM_FIXED(y) & 0xF);
         int32 lineRemain = currentScreen->pitch;
 
         int32 tx       = x >> 20;
-        uint16 *layout = &layer->layout[tx + ((y >> 20) << layer->widthShift)];
+        int32 ty       = y >> 20;
+        uint16 *layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
         lineRemain -= tileRemain;
 
-        if (*layout >= 0xFFFF) {
+        if (*layout >= 0xFFFF || (tileEmptyRows[*layout & 0xFFF] & rowMask)) {
             frameBuffer += tileRemain;
         }
+        else if (tileOpaqueRows[*layout & 0xFFF] & rowMask) {
+            uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY + sheetX];
+#if RETRO_USE_TILE_CACHE
+            uint16 *colors = GetTileColors(paletteBank, *layout & 0xFFF);
+            if (colors) {
+                memcpy(frameBuffer, &colors[sheetY + sheetX], tileRemain * sizeof(uint16));
+                frameBuffer += tileRemain;
+            }
+            else
+#endif
+                for (int32 x = 0; x < tileRemain; ++x) *frameBuffer++ = activePalette[*pixels++];
+        }
         else {
             uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY + sheetX];
             for (int32 x = 0; x < tileRemain; ++x) {
@@ -1335,14 +1596,25 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
         }
 
         for (int32 l = 0; l < lineTileCount; ++l) {
-            ++layout;
-
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
-            if (*layout < 0xFFFF) {
+            if (*layout >= 0xFFFF || (tileEmptyRows[*layout & 0xFFF] & rowMask)) {
+                // nothing to draw on this row
+            }
+            else if (tileOpaqueRows[*layout & 0xFFF] & rowMask) {
+                // every pixel on this row is solid, so there's no need to check for transparency
+                uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
+#if RETRO_USE_TILE_CACHE
+                uint16 *colors = GetTileColors(paletteBank, *layout & 0xFFF);
+                if (colors)
+                    memcpy(frameBuffer, &colors[sheetY], TILE_SIZE * sizeof(uint16));
+                else
+#endif
+                    for (int32 x = 0; x < TILE_SIZE; ++x) frameBuffer[x] = activePalette[pixels[x]];
+            }
+            else {
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
 
                 uint8 index = *pixels;
@@ -1415,18 +1687,27 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
         }
 
         while (lineRemain > 0) {
-            ++layout;
-
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             tileRemain = lineRemain >= TILE_SIZE ? TILE_SIZE : lineRemain;
 
-            if (*layout >= 0xFFFF) {
+            if (*layout >= 0xFFFF || (tileEmptyRows[*layout & 0xFFF] & rowMask)) {
                 frameBuffer += tileRemain;
             }
+            else if (tileOpaqueRows[*layout & 0xFFF] & rowMask) {
+                uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
+#if RETRO_USE_TILE_CACHE
+                uint16 *colors = GetTileColors(paletteBank, *layout & 0xFFF);
+                if (colors) {
+                    memcpy(frameBuffer, &colors[sheetY], tileRemain * sizeof(uint16));
+                    frameBuffer += tileRemain;
+                }
+                else
+#endif
+                    for (int32 x = 0; x < tileRemain; ++x) *frameBuffer++ = activePalette[*pixels++];
+            }
             else {
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetY];
                 for (int32 x = 0; x < tileRemain; ++x) {
@@ -1445,6 +1726,8 @@ void RSDK::DrawLayerHScroll(TileLayer *layer)
 }
 void RSDK::DrawLayerVScroll(TileLayer *layer)
 {
+    PROFILE_SCOPE("DrawLayerVScroll");
+
     if (!layer->xsize || !layer->ysize)
         return;
 
@@ -1468,7 +1751,8 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
         int32 sheetY     = FROM_FIXED(y) & 0xF;
         int32 lineRemain = currentScreen->size.y;
 
-        uint16 *layout = &layer->layout[(x >> 20) + ((y >> 20) << layer->widthShift)];
+        int32 tx       = x >> 20;
+        uint16 *layout = &layer->layout[GetLayoutIndex(layer, tx, y >> 20)];
         lineRemain -= tileRemain;
 
         if (*layout >= 0xFFFF) {
@@ -1486,16 +1770,43 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
 
         ty = y >> 20;
         for (int32 l = 0; l < lineTileCount; ++l) {
+#if RETRO_USE_CHUNKED_LAYOUT
+            if (++ty == layer->ysize)
+                ty = 0;
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
+#else
             layout += layer->xsize;
 
             if (++ty == layer->ysize) {
                 ty = 0;
                 layout -= layer->ysize << layer->widthShift;
             }
+#endif
 
-            if (*layout >= 0xFFFF) {
+            if (*layout >= 0xFFFF || tileEmptyRows[*layout & 0xFFF] == 0xFFFF) {
                 frameBuffer += TILE_SIZE * currentScreen->pitch;
             }
+            else if (tileOpaqueRows[*layout & 0xFFF] == 0xFFFF) {
+                // every row is solid, so every column is too
+                uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetX];
+#if RETRO_USE_TILE_CACHE
+                uint16 *colors = GetTileColors(gfxLineBuffer[0], *layout & 0xFFF);
+                if (colors) {
+                    colors += sheetX;
+                    for (int32 y = 0; y < TILE_SIZE; ++y) {
+                        *frameBuffer = *colors;
+                        colors += TILE_SIZE;
+                        frameBuffer += currentScreen->pitch;
+                    }
+                }
+                else
+#endif
+                    for (int32 y = 0; y < TILE_SIZE; ++y) {
+                        *frameBuffer = activePalette[*pixels];
+                        pixels += TILE_SIZE;
+                        frameBuffer += currentScreen->pitch;
+                    }
+            }
             else {
                 uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF) + sheetX];
 
@@ -1554,12 +1865,18 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
         }
 
         while (lineRemain > 0) {
+#if RETRO_USE_CHUNKED_LAYOUT
+            if (++ty == layer->ysize)
+                ty = 0;
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
+#else
             layout += layer->xsize;
 
             if (++ty == layer->ysize) {
                 ty = 0;
                 layout -= layer->ysize << layer->widthShift;
             }
+#endif
 
             tileRemain = lineRemain >= TILE_SIZE ? TILE_SIZE : lineRemain;
             if (*layout >= 0xFFFF) {
@@ -1587,6 +1904,8 @@ void RSDK::DrawLayerVScroll(TileLayer *layer)
 }
 void RSDK::DrawLayerRotozoom(TileLayer *layer)
 {
+    PROFILE_SCOPE("DrawLayerRotozoom");
+
     if (!layer->xsize || !layer->ysize)
         return;
 
@@ -1613,7 +1932,7 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
             int32 x  = FROM_FIXED(posX) & 0xF;
             int32 y  = FROM_FIXED(posY) & 0xF;
 
-            uint16 tile = layout[((width >> 4) & tx) + (((height >> 4) & ty) << layer->widthShift)] & 0xFFF;
+            uint16 tile = layout[GetLayoutIndex(layer, (width >> 4) & tx, (height >> 4) & ty)] & 0xFFF;
             uint8 idx   = tilesetPixels[TILE_SIZE * (y + TILE_SIZE * tile) + x];
 
             if (idx)
@@ -1630,6 +1949,8 @@ void RSDK::DrawLayerRotozoom(TileLayer *layer)
 }
 void RSDK::DrawLayerBasic(TileLayer *layer)
 {
+    PROFILE_SCOPE("DrawLayerBasic");
+
     if (!layer->xsize || !layer->ysize)
         return;
 
@@ -1650,7 +1971,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
         int32 tileRemainY = TILE_SIZE - sheetY;
 
         uint16 *frameBuffer = &currentScreen->frameBuffer[currentScreen->clipBound_X1 + currentScreen->clipBound_Y1 * currentScreen->pitch];
-        uint16 *layout      = &layer->layout[tx + (ty << layer->widthShift)];
+        uint16 *layout      = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
         // Remaining pixels on top
         {
@@ -1675,11 +1996,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                 frameBuffer += tileRemainX - currentScreen->pitch * tileRemainY;
             }
 
-            ++layout;
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             for (int32 x = 0; x < lineSize; ++x) {
                 if (*layout == 0xFFFF) {
@@ -1759,11 +2078,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                     frameBuffer += TILE_SIZE - currentScreen->pitch * tileRemainY;
                 }
 
-                ++layout;
-                if (++tx == layer->xsize) {
+                if (++tx == layer->xsize)
                     tx = 0;
-                    layout -= layer->xsize;
-                }
+                layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
             }
 
             if (*layout == 0xFFFF) {
@@ -1798,7 +2115,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
             sheetX      = (currentScreen->clipBound_X1 + FROM_FIXED(scanline->position.x)) & 0xF;
             tx          = (currentScreen->clipBound_X1 + FROM_FIXED(scanline->position.x)) >> 4;
             tileRemainX = TILE_SIZE - sheetX;
-            layout      = &layer->layout[tx + (ty << layer->widthShift)];
+            layout      = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             // Draw any stray pixels on the left
             if (*layout == 0xFFFF) {
@@ -1821,15 +2138,37 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
 
                 frameBuffer += tileRemainX - TILE_SIZE * currentScreen->pitch;
             }
-            ++layout;
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             // Draw the bulk of the tiles on this line
             for (int32 x = 0; x < lineSize; ++x) {
-                if (*layout == 0xFFFF) {
+                if (*layout == 0xFFFF || tileEmptyRows[*layout & 0xFFF] == 0xFFFF) {
+                    frameBuffer += TILE_SIZE;
+                }
+                else if (tileOpaqueRows[*layout & 0xFFF] == 0xFFFF) {
+                    uint8 *pixels = &tilesetPixels[TILE_DATASIZE * (*layout & 0xFFF)];
+#if RETRO_USE_TILE_CACHE
+                    uint16 *colors = GetTileColors(0, *layout & 0xFFF);
+                    if (colors) {
+                        for (int32 y = 0; y < TILE_SIZE; ++y) {
+                            memcpy(frameBuffer, colors, TILE_SIZE * sizeof(uint16));
+
+                            colors += TILE_SIZE;
+                            frameBuffer += currentScreen->pitch;
+                        }
+                    }
+                    else
+#endif
+                        for (int32 y = 0; y < TILE_SIZE; ++y) {
+                            for (int32 x = 0; x < TILE_SIZE; ++x) frameBuffer[x] = activePalette[pixels[x]];
+
+                            pixels += TILE_SIZE;
+                            frameBuffer += currentScreen->pitch;
+                        }
+
+                    frameBuffer -= TILE_SIZE * currentScreen->pitch;
                     frameBuffer += TILE_SIZE;
                 }
                 else {
@@ -1908,11 +2247,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                     frameBuffer += TILE_SIZE;
                 }
 
-                ++layout;
-                if (++tx == layer->xsize) {
+                if (++tx == layer->xsize)
                     tx = 0;
-                    layout -= layer->xsize;
-                }
+                layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
             }
 
             // Draw any stray pixels on the right
@@ -1934,11 +2271,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                     frameBuffer += currentScreen->pitch - sheetX;
                 }
             }
-            ++layout;
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             // We've drawn a single line, increase our variables
             scanline += TILE_SIZE;
@@ -1952,7 +2287,7 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
             tx          = (currentScreen->clipBound_X1 + FROM_FIXED(scanline->position.x)) >> 4;
             sheetX      = (currentScreen->clipBound_X1 + FROM_FIXED(scanline->position.x)) & 0xF;
             tileRemainX = TILE_SIZE - sheetX;
-            layout      = &layer->layout[tx + (ty << layer->widthShift)];
+            layout      = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             if (*layout != 0xFFFF) {
                 frameBuffer += tileRemainX;
@@ -1974,11 +2309,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
 
                 frameBuffer += tileRemainX - currentScreen->pitch * sheetY;
             }
-            ++layout;
-            if (++tx == layer->xsize) {
+            if (++tx == layer->xsize)
                 tx = 0;
-                layout -= layer->xsize;
-            }
+            layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
 
             for (int32 x = 0; x < lineSize; ++x) {
                 if (*layout == 0xFFFF) {
@@ -2058,11 +2391,9 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
                     frameBuffer += TILE_SIZE - currentScreen->pitch * sheetY;
                 }
 
-                ++layout;
-                if (++tx == layer->xsize) {
+                if (++tx == layer->xsize)
                     tx = 0;
-                    layout -= layer->xsize;
-                }
+                layout = &layer->layout[GetLayoutIndex(layer, tx, ty)];
             }
 
             if (*layout != 0xFFFF) {
@@ -2084,3 +2415,263 @@ void RSDK::DrawLayerBasic(TileLayer *layer)
         }
     }
 }
+
+#if RETRO_USE_LAYER_CACHE
+static void DrawLayerCacheTile(LayerCacheTile *cacheTile, uint16 tile, uint16 *activePalette)
+{
+    if (tile >= 0xFFFF) {
+        memset(cacheTile->rowMasks, 0, sizeof(cacheTile->rowMasks));
+        return;
+    }
+
+    uint8 *pixels  = &tilesetPixels[TILE_DATASIZE * (tile & 0xFFF)];
+    uint16 *colors = cacheTile->pixels;
+    for (int32 y = 0; y < TILE_SIZE; ++y) {
+        uint16 rowMask = 0;
+        for (int32 x = 0; x < TILE_SIZE; ++x) {
+            if (*pixels) {
+                *colors = activePalette[*pixels];
+                rowMask |= 1 << x;
+            }
+            ++pixels;
+            ++colors;
+        }
+
+        cacheTile->rowMasks[y] = rowMask;
+    }
+}
+
+#if RETRO_VERIFY_LAYER_CACHE
+// draws the layer both from the cache & the normal way onto scratch screens with the same garbage behind it & checks they match
+static void VerifyLayerCache(uint16 layerID, uint8 screenID)
+{
+    static ScreenInfo *verifyScreens[2] = { NULL, NULL };
+    for (int32 v = 0; v < 2; ++v) {
+        if (!verifyScreens[v])
+            verifyScreens[v] = (ScreenInfo *)malloc(sizeof(ScreenInfo));
+        if (!verifyScreens[v])
+            return;
+    }
+
+    TileLayer *layer       = &tileLayers[layerID];
+    ScreenInfo *prevScreen = currentScreen;
+    for (int32 v = 0; v < 2; ++v) {
+        ScreenInfo *screen = verifyScreens[v];
+        memcpy((uint8 *)screen + sizeof(screen->frameBuffer), (uint8 *)prevScreen + sizeof(screen->frameBuffer),
+               sizeof(ScreenInfo) - sizeof(screen->frameBuffer));
+        for (int32 p = 0; p < screen->pitch * screen->size.y; ++p) screen->frameBuffer[p] = (uint16)(p * 0x9E37);
+
+        currentScreen = screen;
+        if (v)
+            DrawLayerCache(layerID, screenID);
+        else if (layer->type == LAYER_HSCROLL)
+            DrawLayerHScroll(layer);
+        else
+            DrawLayerBasic(layer);
+    }
+    currentScreen = prevScreen;
+
+    for (int32 y = 0; y < prevScreen->size.y; ++y) {
+        for (int32 x = 0; x < prevScreen->pitch; ++x) {
+            int32 p = x + y * prevScreen->pitch;
+            if (verifyScreens[0]->frameBuffer[p] != verifyScreens[1]->frameBuffer[p]) {
+                PrintLog(PRINT_NORMAL, "Layer cache mismatch: layer %d, screen %d, pixel (%d, %d), scroll (%d, %d)", layerID, screenID, x, y,
+                         FROM_FIXED(scanlines->position.x), FROM_FIXED(scanlines->position.y));
+                return;
+            }
+        }
+    }
+}
+#endif
+
+bool32 RSDK::UpdateLayerCache(uint16 layerID, uint8 screenID)
+{
+    TileLayer *layer = &tileLayers[layerID];
+    if ((layer->type != LAYER_HSCROLL && layer->type != LAYER_BASIC) || layer->scanlineCallback || !layer->xsize || !layer->ysize)
+        return false;
+
+    int32 pixelWidth  = TILE_SIZE * layer->xsize;
+    int32 pixelHeight = TILE_SIZE * layer->ysize;
+    int32 scrollX     = FROM_FIXED(scanlines->position.x);
+    int32 layerX      = WrapLayerPos(scrollX, pixelWidth);
+    int32 layerY      = FROM_FIXED(scanlines->position.y);
+    if (layerY < 0 || layerY >= pixelHeight)
+        return false;
+
+    // basic layers always draw with the first bank
+    uint8 paletteBank = layer->type == LAYER_HSCROLL ? gfxLineBuffer[0] : 0;
+    if (tileColorDisabledBanks.load(std::memory_order_relaxed) >> paletteBank & 1)
+        return false;
+
+    // it only works if the whole screen scrolls as one block, any per-line scrolling or deformation has to go through the normal drawers
+    int32 lineY = layerY;
+    for (int32 y = 0; y < currentScreen->size.y; ++y) {
+        if (FROM_FIXED(scanlines[y].position.x) != scrollX || FROM_FIXED(scanlines[y].position.y) != lineY)
+            return false;
+
+        if (layer->type == LAYER_HSCROLL && gfxLineBuffer[y] != paletteBank)
+            return false;
+
+        if (++lineY == pixelHeight)
+            lineY = 0;
+    }
+
+    LayerCache *cache = &layerCaches[screenID][layerID];
+    // enough tiles to cover the screen at any sub-tile offset
+    int32 tileCountX  = ((currentScreen->pitch + 0xF) >> 4) + 1;
+    int32 tileCountY  = ((currentScreen->size.y + 0xF) >> 4) + 1;
+    bool32 redraw     = cache->xsize != layer->xsize || cache->ysize != layer->ysize || cache->paletteBank != paletteBank
+                    || cache->paletteVersion != paletteVersion[paletteBank];
+
+    if (cache->tileCountX != tileCountX || cache->tileCountY != tileCountY) {
+        free(cache->tiles);
+        cache->tiles      = (LayerCacheTile *)malloc(tileCountX * tileCountY * sizeof(LayerCacheTile));
+        cache->tileCountX = cache->tiles ? tileCountX : 0;
+        cache->tileCountY = cache->tiles ? tileCountY : 0;
+        if (!cache->tiles)
+            return false;
+
+        redraw = true;
+    }
+
+    if (redraw) {
+        for (int32 t = 0; t < tileCountX * tileCountY; ++t) cache->tiles[t].x = LAYERCACHE_TILE_UNUSED;
+
+        cache->viewX          = layerX;
+        cache->viewY          = layerY;
+        cache->xsize          = layer->xsize;
+        cache->ysize          = layer->ysize;
+        cache->paletteBank    = paletteBank;
+        cache->paletteVersion = paletteVersion[paletteBank];
+    }
+    else {
+        // the layer may have wrapped around since last time, so take the shortest way there
+        int32 moveX = layerX - cache->layerX;
+        if (moveX > pixelWidth / 2)
+            moveX -= pixelWidth;
+        else if (moveX < -pixelWidth / 2)
+            moveX += pixelWidth;
+
+        int32 moveY = layerY - cache->layerY;
+        if (moveY > pixelHeight / 2)
+            moveY -= pixelHeight;
+        else if (moveY < -pixelHeight / 2)
+            moveY += pixelHeight;
+
+        cache->viewX += moveX;
+        cache->viewY += moveY;
+    }
+    cache->layerX = layerX;
+    cache->layerY = layerY;
+
+    // go over every tile on screen, only the ones that just scrolled in or have been changed since they were cached need drawing
+    // (SetTile, CopyTileLayer & anything writing to the layout directly show up as a different layout entry, tile edits as a new tileVersion)
+    uint16 *activePalette = fullPalette[paletteBank];
+    int32 tileY           = cache->viewY >> 4;
+    int32 ty              = WrapLayerPos(tileY, layer->ysize);
+    int32 cacheY          = WrapLayerPos(tileY, tileCountY);
+    for (int32 y = 0; y < tileCountY; ++y) {
+        int32 tileX              = cache->viewX >> 4;
+        int32 tx                 = WrapLayerPos(tileX, layer->xsize);
+        int32 cacheX             = WrapLayerPos(tileX, tileCountX);
+        LayerCacheTile *cacheRow = &cache->tiles[cacheY * tileCountX];
+
+        for (int32 x = 0; x < tileCountX; ++x) {
+            LayerCacheTile *cacheTile = &cacheRow[cacheX];
+            uint16 tile               = layer->layout[GetLayoutIndex(layer, tx, ty)];
+            uint32 version            = tile < 0xFFFF ? tileVersion[tile & 0xFFF] : 0;
+
+            if (cacheTile->x != tileX + x || cacheTile->y != tileY + y || cacheTile->tile != tile || cacheTile->version != version) {
+                cacheTile->x       = tileX + x;
+                cacheTile->y       = tileY + y;
+                cacheTile->tile    = tile;
+                cacheTile->version = version;
+                DrawLayerCacheTile(cacheTile, tile, activePalette);
+            }
+
+            if (++tx == layer->xsize)
+                tx = 0;
+            if (++cacheX == tileCountX)
+                cacheX = 0;
+        }
+
+        if (++ty == layer->ysize)
+            ty = 0;
+        if (++cacheY == tileCountY)
+            cacheY = 0;
+    }
+
+#if RETRO_VERIFY_LAYER_CACHE
+    VerifyLayerCache(layerID, screenID);
+#endif
+
+    return true;
+}
+
+void RSDK::DrawLayerCache(uint16 layerID, uint8 screenID)
+{
+    PROFILE_SCOPE("DrawLayerCache");
+
+    TileLayer *layer  = &tileLayers[layerID];
+    LayerCache *cache = &layerCaches[screenID][layerID];
+
+    // cover the same area DrawLayerHScroll/DrawLayerBasic would have
+    int32 startX = 0;
+    int32 endX   = currentScreen->pitch;
+    if (layer->type == LAYER_BASIC) {
+        startX = currentScreen->clipBound_X1;
+        endX   = currentScreen->clipBound_X2;
+    }
+
+    if (startX >= endX)
+        return;
+
+    for (int32 cy = currentScreen->clipBound_Y1; cy < currentScreen->clipBound_Y2; ++cy) {
+        int32 lineY              = cache->viewY + cy;
+        int32 sheetY             = lineY & 0xF;
+        LayerCacheTile *cacheRow = &cache->tiles[WrapLayerPos(lineY >> 4, cache->tileCountY) * cache->tileCountX];
+
+        int32 lineX         = cache->viewX + startX;
+        int32 sheetX        = lineX & 0xF;
+        int32 cacheX        = WrapLayerPos(lineX >> 4, cache->tileCountX);
+        int32 lineRemain    = endX - startX;
+        uint16 *frameBuffer = &currentScreen->frameBuffer[startX + cy * currentScreen->pitch];
+
+        while (lineRemain > 0) {
+            LayerCacheTile *cacheTile = &cacheRow[cacheX];
+            int32 tileRemain          = MIN(TILE_SIZE - sheetX, lineRemain);
+            uint16 rowMask            = cacheTile->rowMasks[sheetY];
+            uint16 *pixels            = &cacheTile->pixels[TILE_SIZE * sheetY + sheetX];
+
+            if (rowMask == 0xFFFF) {
+                memcpy(frameBuffer, pixels, tileRemain * sizeof(uint16));
+            }
+            else if (rowMask) {
+                rowMask >>= sheetX;
+                for (int32 x = 0; x < tileRemain; ++x) {
+                    if (rowMask >> x & 1)
+                        frameBuffer[x] = pixels[x];
+                }
+            }
+
+            frameBuffer += tileRemain;
+            lineRemain -= tileRemain;
+            sheetX = 0;
+            if (++cacheX == cache->tileCountX)
+                cacheX = 0;
+        }
+    }
+}
+
+void RSDK::ReleaseLayerCaches()
+{
+    for (int32 s = 0; s < SCREEN_COUNT; ++s) {
+        for (int32 l = 0; l < LAYER_COUNT; ++l) {
+            free(layerCaches[s][l].tiles);
+            layerCaches[s][l].tiles      = NULL;
+            layerCaches[s][l].tileCountX = 0;
+            layerCaches[s][l].tileCountY = 0;
+        }
+    }
+}
+#endif
@@ -146,12 +146,93 @@ struct TileInfo {
     uint8 flag;
 };
 
-extern ScanlineInfo *scanlines;
+extern RETRO_RENDER_TLS ScanlineInfo *scanlines;
 extern TileLayer tileLayers[LAYER_COUNT];
 
+#if RETRO_USE_CHUNKED_LAYOUT
+#define LAYOUT_CHUNK_SHIFT (3)
+#define LAYOUT_CHUNK_MASK  ((1 << LAYOUT_CHUNK_SHIFT) - 1)
+#endif
+
+// where a tile lives in a layer's layout, everything that reads or writes a layout should go through this
+inline int32 GetLayoutIndex(TileLayer *layer, int32 tileX, int32 tileY)
+{
+#if RETRO_USE_CHUNKED_LAYOUT
+    int32 chunk = (tileX >> LAYOUT_CHUNK_SHIFT) + ((tileY >> LAYOUT_CHUNK_SHIFT) << (layer->widthShift - LAYOUT_CHUNK_SHIFT));
+    return (chunk << (LAYOUT_CHUNK_SHIFT * 2)) + ((tileY & LAYOUT_CHUNK_MASK) << LAYOUT_CHUNK_SHIFT) + (tileX & LAYOUT_CHUNK_MASK);
+#else
+    return tileX + (tileY << layer->widthShift);
+#endif
+}
+
 extern CollisionMask collisionMasks[CPATH_COUNT][TILE_COUNT * 4]; // 1024 * 1 per direction
 extern TileInfo tileInfo[CPATH_COUNT][TILE_COUNT * 4];            // 1024 * 1 per direction
 
+#if RETRO_USE_SOLIDITY_BITMAPS
+#define SOLIDITY_BLOCK_SHIFT (3)
+#define SOLIDITY_BLOCK_MASK  ((1 << SOLIDITY_BLOCK_SHIFT) - 1)
+#define SOLIDITY_FLAG_COUNT  (4)
+
+// a bit per tile for each of the solidity flags (bits 12-15 of a layout entry), the bits are grouped into 8x8 tile blocks so a few tiles
+// in a row or column (like the 3 a collision sensor checks) are almost always in the same word
+struct TileLayerSolidity {
+    uint64 *blocks; // SOLIDITY_FLAG_COUNT words per block, row by row
+    uint16 *layout; // the layout these were built from, if the layer's been pointed somewhere else these can't be trusted
+    int32 blockCountX;
+    int32 blockCountY;
+    // set once the layer's been handed out through GetTileLayer, after which its layout could be written to without going through SetTile
+    // so tile collision goes back to reading the layout for it (until the next scene load)
+    bool32 shared;
+};
+
+extern TileLayerSolidity layerSolidity[LAYER_COUNT];
+
+// collisionMasks rearranged to [plane][cMode][tile], so every tile's masks for one direction are back to back
+extern uint8 tileHeightFields[CPATH_COUNT][4][TILE_COUNT * 4][TILE_SIZE];
+// set once anything's been given collisionMasks to write to directly, after which tile collision goes back to reading collisionMasks
+extern bool32 tileHeightFieldsShared;
+
+// (re)builds a layer's bitmap from its layout, allocating it if it needs to be
+void RefreshLayerSolidity(uint16 layerID);
+// rebuilds tileHeightFields from collisionMasks for a tile (or every tile in both planes for RefreshTileHeightFields)
+void UpdateTileHeightFields(uint8 cPlane, uint16 tile);
+void RefreshTileHeightFields();
+
+inline void UpdateTileSolidity(uint16 layerID, int32 tileX, int32 tileY, uint16 tile)
+{
+    TileLayerSolidity *solidity = &layerSolidity[layerID];
+    if (!solidity->blocks)
+        return;
+
+    int32 blockID = (tileX >> SOLIDITY_BLOCK_SHIFT) + (tileY >> SOLIDITY_BLOCK_SHIFT) * solidity->blockCountX;
+    uint64 *block = &solidity->blocks[blockID * SOLIDITY_FLAG_COUNT];
+    uint64 bit    = (uint64)1 << (((tileY & SOLIDITY_BLOCK_MASK) << SOLIDITY_BLOCK_SHIFT) + (tileX & SOLIDITY_BLOCK_MASK));
+    for (int32 f = 0; f < SOLIDITY_FLAG_COUNT; ++f) {
+        if (tile != 0xFFFF && (tile & (1 << (12 + f))))
+            block[f] |= bit;
+        else
+            block[f] &= ~bit;
+    }
+}
+#endif
+
+// the collision mask height for column/row "pos" of a tile, what collisionMasks has for it but from the packed copy when it can be
+inline uint8 GetTileHeight(uint8 cPlane, uint8 cMode, uint16 tile, int32 pos)
+{
+#if RETRO_USE_SOLIDITY_BITMAPS
+    if (!tileHeightFieldsShared)
+        return tileHeightFields[cPlane][cMode][tile & 0xFFF][pos];
+#endif
+
+    switch (cMode) {
+        default:
+        case CMODE_FLOOR: return collisionMasks[cPlane][tile & 0xFFF].floorMasks[pos];
+        case CMODE_LWALL: return collisionMasks[cPlane][tile & 0xFFF].lWallMasks[pos];
+        case CMODE_ROOF: return collisionMasks[cPlane][tile & 0xFFF].roofMasks[pos];
+        case CMODE_RWALL: return collisionMasks[cPlane][tile & 0xFFF].rWallMasks[pos];
+    }
+}
+
 #if RETRO_REV02
 extern bool32 forceHardReset;
 #endif
@@ -165,11 +246,25 @@ extern SceneInfo sceneInfo;
 
 extern uint8 tilesetPixels[TILESET_SIZE * 4];
 
+// a bit per tile row, set if every pixel on that row is transparent (empty) or solid (opaque), rows with neither are mixed
+// indexed the same as tilesetPixels, so the flipped copies (tile | (direction << 10)) get their own entries
+extern uint16 tileEmptyRows[TILE_COUNT * 4];
+extern uint16 tileOpaqueRows[TILE_COUNT * 4];
+
 void LoadSceneFolder();
 void LoadSceneAssets();
 void LoadTileConfig(char *filepath);
 void LoadStageGIF(char *filepath);
 
+// Should be called after anything writes to tilesetPixels, so the layer drawers keep skipping the right rows
+void UpdateTileRowInfo(uint16 tile, uint16 count);
+
+#if RETRO_USE_TILE_CACHE
+// Stops tiles drawn with this bank from being cached, for when the bank can be written to without paletteVersion being updated
+void DisableTileColorCache(uint8 bankID);
+void ReleaseTileColorCache();
+#endif
+
 void ProcessParallaxAutoScroll();
 void ProcessParallax(TileLayer *layer);
 void ProcessSceneTimer();
@@ -211,7 +306,17 @@ inline uint16 GetTileLayerID(const char *name)
     return (uint16)-1;
 }
 
-inline TileLayer *GetTileLayer(uint16 layerID) { return layerID < LAYER_COUNT ? &tileLayers[layerID] : NULL; }
+inline TileLayer *GetTileLayer(uint16 layerID)
+{
+    if (layerID >= LAYER_COUNT)
+        return NULL;
+
+#if RETRO_USE_SOLIDITY_BITMAPS
+    // no way of knowing when (or what) they'll write to the layout, so the bitmap can't be used for this layer from here on
+    layerSolidity[layerID].shared = true;
+#endif
+    return &tileLayers[layerID];
+}
 
 inline void GetLayerSize(uint16 layerID, Vector2 *size, bool32 usePixelUnits)
 {
@@ -234,7 +339,7 @@ inline uint16 GetTile(uint16 layerID, int32 tileX, int32 tileY)
     if (layerID < LAYER_COUNT) {
         TileLayer *layer = &tileLayers[layerID];
         if (tileX >= 0 && tileX < layer->xsize && tileY >= 0 && tileY < layer->ysize)
-            return layer->layout[tileX + (tileY << layer->widthShift)];
+            return layer->layout[GetLayoutIndex(layer, tileX, tileY)];
     }
 
     return (uint16)-1;
@@ -244,8 +349,13 @@ inline void SetTile(uint16 layerID, int32 tileX, int32 tileY, uint16 tile)
 {
     if (layerID < LAYER_COUNT) {
         TileLayer *layer = &tileLayers[layerID];
-        if (tileX >= 0 && tileX < layer->xsize && tileY >= 0 && tileY < layer->ysize)
-            layer->layout[tileX + (tileY << layer->widthShift)] = tile;
+        if (tileX >= 0 && tileX < layer->xsize && tileY >= 0 && tileY < layer->ysize) {
+            SyncDrawCommands();
+            layer->layout[GetLayoutIndex(layer, tileX, tileY)] = tile;
+#if RETRO_USE_SOLIDITY_BITMAPS
+            UpdateTileSolidity(layerID, tileX, tileY, tile);
+#endif
+        }
     }
 }
 
@@ -287,6 +397,7 @@ inline void CopyTile(uint16 dest, uint16 src, uint16 count)
     if (count > TILE_COUNT)
         count = TILE_COUNT - 1;
 
+    SyncDrawCommands();
     uint8 *destPixels = &tilesetPixels[TILE_DATASIZE * dest];
     uint8 *srcPixels  = &tilesetPixels[TILE_DATASIZE * src];
 
@@ -307,6 +418,8 @@ inline void CopyTile(uint16 dest, uint16 src, uint16 count)
             *destPixelsXY++ = *srcPixelsXY++;
         }
     }
+
+    UpdateTileRowInfo(dest, count);
 }
 
 inline ScanlineInfo *GetScanlines() { return scanlines; }
@@ -320,6 +433,14 @@ void DrawLayerRotozoom(TileLayer *layer);
 // Draw a "basic" layer, no special capabilities, but it's the fastest to draw
 void DrawLayerBasic(TileLayer *layer);
 
+#if RETRO_USE_LAYER_CACHE
+// Brings screenID's cached copy of the layer in line with its scanlines, returns false if the layer can't be drawn from the cache
+bool32 UpdateLayerCache(uint16 layerID, uint8 screenID);
+// Draw a layer straight from the cache UpdateLayerCache just filled in
+void DrawLayerCache(uint16 layerID, uint8 screenID);
+void ReleaseLayerCaches();
+#endif
+
 #if RETRO_REV0U
 #include "Legacy/SceneLegacy.hpp"
 #endif
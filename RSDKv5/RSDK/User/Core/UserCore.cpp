@@ -364,6 +364,12 @@ void RSDK::LoadSettingsINI()
 #if !RETRO_USE_ORIGINAL_CODE
         customSettings.maxPixWidth = iniparser_getint(ini, "Video:maxPixWidth", DEFAULT_PIXWIDTH);
 #endif
+#if RETRO_USE_DRAW_COMMANDS
+        customSettings.deferDrawing = iniparser_getboolean(ini, "Video:deferDrawing", true);
+#endif
+#if RETRO_USE_RENDER_THREADS
+        customSettings.renderThreads = iniparser_getint(ini, "Video:renderThreads", 0);
+#endif
 
         engine.streamsEnabled = iniparser_getboolean(ini, "Audio:streamsEnabled", true);
         engine.streamVolume   = (float)iniparser_getdouble(ini, "Audio:streamVolume", 0.8);
@@ -523,6 +529,12 @@ void RSDK::LoadSettingsINI()
         customSettings.username[0] = 0;
 
         customSettings.maxPixWidth = DEFAULT_PIXWIDTH;
+#if RETRO_USE_DRAW_COMMANDS
+        customSettings.deferDrawing = true;
+#endif
+#if RETRO_USE_RENDER_THREADS
+        customSettings.renderThreads = 0;
+#endif
 
         if (customSettings.region >= 0) {
 #if RETRO_REV02
@@ -663,6 +675,14 @@ void RSDK::SaveSettingsINI(bool32 writeToFile)
         WriteText(file, "; Maximum width the screen will be allowed to be. A value of 0 will disable the maximum width\n");
         WriteText(file, "maxPixWidth=%d\n", customSettings.maxPixWidth);
 #endif
+#if RETRO_USE_DRAW_COMMANDS
+        WriteText(file, "; Records each draw group's draw calls and draws them once the group is done, instead of as they're made\n");
+        WriteText(file, "deferDrawing=%s\n", (customSettings.deferDrawing ? "y" : "n"));
+#endif
+#if RETRO_USE_RENDER_THREADS
+        WriteText(file, "; Number of bands each screen is split into to draw across threads. A value of 0 or 1 will draw on the main thread\n");
+        WriteText(file, "renderThreads=%d\n", customSettings.renderThreads);
+#endif
 
         // ================
         // AUDIO
@@ -184,6 +184,12 @@ struct CustomSettings {
     bool32 forceScripts;
 #endif
     int32 maxPixWidth;
+#if RETRO_USE_DRAW_COMMANDS
+    bool32 deferDrawing;
+#endif
+#if RETRO_USE_RENDER_THREADS
+    int32 renderThreads;
+#endif
     char username[0x80];
 };
 
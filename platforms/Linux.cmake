@@ -78,6 +78,8 @@ elseif(RETRO_SUBSYSTEM STREQUAL "SDL2")
     target_link_libraries(RetroEngine ${SDL2_STATIC_LIBRARIES})
     target_link_options(RetroEngine PRIVATE ${SDL2_STATIC_LDLIBS_OTHER})
     target_compile_options(RetroEngine PRIVATE ${SDL2_STATIC_CFLAGS})
+elseif(RETRO_SUBSYSTEM STREQUAL "NULL")
+    # headless, nothing extra to link
 endif()
 
 if(NOT RETRO_SUBSYSTEM STREQUAL SDL2)